@@ -108,6 +108,149 @@ struct ContainerResize<T, false>
   }
 };
 
+/*!
+ * Helper class for ContainerSerializationDefault
+ * (allows copying elements of contiguous containers with bulk-serializable elements in one block)
+ */
+template <typename T, bool BULK_SERIALIZABLE = IsBulkSerializable<T>::value>
+struct ContainerElementSerialization
+{
+  template <typename TContainer>
+  static void Serialize(tOutputStream& stream, const TContainer& container)
+  {
+    stream.EnsureAdditionalCapacity(container.size() * FixedSerializedSize<T>::value);  // single capacity check for elements with fixed size
+    for (auto it = container.begin(); it != container.end(); it++)
+    {
+      stream << *it;
+    }
+  }
+
+  template <typename TContainer>
+  static void Deserialize(tInputStream& stream, TContainer& container)
+  {
+    for (auto it = container.begin(); it != container.end(); it++)
+    {
+      stream >> *it;
+    }
+  }
+};
+
+template <typename T>
+struct ContainerElementSerialization<T, true> : public ContainerElementSerialization<T, false>
+{
+  using ContainerElementSerialization<T, false>::Serialize;
+  using ContainerElementSerialization<T, false>::Deserialize;
+
+  template <typename TAlloc>
+  static void Serialize(tOutputStream& stream, const std::vector<T, TAlloc>& container)
+  {
+    internal::WriteBulk(stream, container.data(), container.size());
+  }
+
+  template <typename TAlloc>
+  static void Deserialize(tInputStream& stream, std::vector<T, TAlloc>& container)
+  {
+    internal::ReadBulk(stream, container.data(), container.size());
+  }
+};
+
+/*!
+ * Bool containers: std::vector<bool> may be written in bit-packed format (see tOutputStream::SetPackedBoolVectors).
+ * Elements are packed into 64 bit words (least significant bit first).
+ * The last incomplete word is written with as few bytes as possible.
+ */
+template <>
+struct ContainerElementSerialization<bool, false>
+{
+  template <typename TContainer>
+  static void Serialize(tOutputStream& stream, const TContainer& container)
+  {
+    for (auto it = container.begin(); it != container.end(); it++)
+    {
+      stream << *it;
+    }
+  }
+
+  template <typename TContainer>
+  static void Deserialize(tInputStream& stream, TContainer& container)
+  {
+    for (auto it = container.begin(); it != container.end(); it++)
+    {
+      stream >> *it;
+    }
+  }
+
+  template <typename TAlloc>
+  static void Serialize(tOutputStream& stream, const std::vector<bool, TAlloc>& container)
+  {
+    if (!stream.GetPackedBoolVectors())
+    {
+      for (auto it = container.begin(); it != container.end(); it++)
+      {
+        stream << *it;
+      }
+      return;
+    }
+
+    size_t size = container.size();
+    for (size_t word_start = 0; word_start < size; word_start += 64)
+    {
+      size_t bits = std::min<size_t>(64, size - word_start);
+      uint64_t word = 0;
+      for (size_t i = 0; i < bits; i++)
+      {
+        word |= static_cast<uint64_t>(container[word_start + i]) << i;
+      }
+      if (bits == 64)
+      {
+        stream.WriteNumber(word);
+      }
+      else
+      {
+        for (size_t i = 0; i < bits; i += 8)
+        {
+          stream.WriteNumber(static_cast<uint8_t>(word >> i));
+        }
+      }
+    }
+  }
+
+  template <typename TAlloc>
+  static void Deserialize(tInputStream& stream, std::vector<bool, TAlloc>& container)
+  {
+    if (!stream.GetPackedBoolVectors())
+    {
+      for (auto it = container.begin(); it != container.end(); it++)
+      {
+        stream >> *it;
+      }
+      return;
+    }
+
+    size_t size = container.size();
+    for (size_t word_start = 0; word_start < size; word_start += 64)
+    {
+      size_t bits = std::min<size_t>(64, size - word_start);
+      uint64_t word = 0;
+      if (bits == 64)
+      {
+        word = stream.ReadNumber<uint64_t>();
+      }
+      else
+      {
+        for (size_t i = 0; i < bits; i += 8)
+        {
+          word |= static_cast<uint64_t>(stream.ReadNumber<uint8_t>()) << i;
+        }
+      }
+      for (size_t i = 0; i < bits; i++)
+      {
+        container[word_start + i] = (word >> i) & 1;
+      }
+    }
+  }
+};
+
 /*!
  * Helper class for ContainerSerializationDefault
  * (allows different deserialization implementation for sets)
@@ -118,17 +261,14 @@ struct ContainerDeserializationDefaulImplementation
   template <typename TContainer>
   static void Deserialize(tInputStream& stream, TContainer& container)
   {
-    size_t size = stream.ReadInt();
+    size_t size = stream.ReadEncodedNumber<uint32_t>();
     bool const_type = stream.ReadBoolean();
     if (!const_type)
     {
       throw std::runtime_error("Only const type deserialization is supported");
     }
     ContainerResize<T>::Resize(container, size);
-    for (auto it = container.begin(); it != container.end(); it++)
-    {
-      stream >> *it;
-    }
+    ContainerElementSerialization<T>::Deserialize(stream, container);
   }
 
 #ifdef _LIB_RRLIB_XML_PRESENT_
@@ -160,7 +300,7 @@ struct ContainerDeserializationDefaulImplementation<T, true>
   template <typename TContainer>
   static void Deserialize(tInputStream& stream, TContainer& container)
   {
-    size_t size = stream.ReadInt();
+    size_t size = stream.ReadEncodedNumber<uint32_t>();
     bool const_type = stream.ReadBoolean();
     if (!const_type)
     {
@@ -213,12 +353,9 @@ struct ContainerSerializationDefault
   template <typename TContainer>
   static void Serialize(tOutputStream& stream, const TContainer& container)
   {
-    stream.WriteInt(container.size());
+    stream.WriteEncodedNumber<uint32_t>(container.size());
     stream.WriteBoolean(true); // const type?  (possibly unnecessary; if we remove it, this will break binary compatibility to 13.10 though)
-    for (auto it = container.begin(); it != container.end(); it++)
-    {
-      stream << *it;
-    }
+    ContainerElementSerialization<T>::Serialize(stream, container);
   }
 
   template <typename TContainer>
@@ -236,7 +373,7 @@ struct ContainerSerializationDefault
   template <typename TMap>
   static void DeserializeMap(tInputStream& stream, TMap& map)
   {
-    typename TMap::size_type size = stream.ReadInt();
+    typename TMap::size_type size = stream.ReadEncodedNumber<uint32_t>();
     bool const_type = stream.ReadBoolean(); // possibly unnecessary (see above)
     if (!const_type)
     {
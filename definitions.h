@@ -35,6 +35,10 @@
 //----------------------------------------------------------------------
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
+#include <array>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 
 //----------------------------------------------------------------------
 // Internal includes with ""
@@ -72,6 +76,99 @@ enum class tTypeEncoding
   CUSTOM       //!< A custom type encoder is used.
 };
 
+/*!
+ * Integer encoding for binary streams.
+ * Applies to container sizes, enum indices and integers written with tOutputStream::WriteEncodedNumber.
+ */
+enum class tIntegerEncoding
+{
+  FIXED,     //!< Integers are written with their fixed size (default - and compatible to streams without this option)
+  VARIABLE   //!< Integers are written in variable-length LEB128 format (signed integers zigzag-encoded). Small values need fewer bytes.
+};
+
+/*!
+ * String encoding for binary streams.
+ * Applies to strings written with tOutputStream::WriteString (apart from unterminated strings).
+ */
+enum class tStringEncoding
+{
+  NULL_TERMINATED,  //!< Strings are terminated with a null character (default - and compatible to streams without this option)
+  LENGTH_PREFIXED   //!< Strings are prefixed with their length (encoded number - see tIntegerEncoding). They may contain null characters and can be read and skipped without scanning them.
+};
+
+/*!
+ * Type trait that defines whether the binary representation of type T in streams
+ * equals its memory representation (apart from the byte order of integral types).
+ * Contiguous sequences of such values (e.g. in std::vector or std::array) are
+ * copied to and from streams in one block.
+ */
+template <typename T>
+struct IsBulkSerializable
+{
+  enum { value = (std::is_integral<T>::value && (!std::is_same<T, bool>::value) && (!std::is_same<T, wchar_t>::value) &&
+                  (!std::is_same<T, char16_t>::value) && (!std::is_same<T, char32_t>::value) &&
+                  (((!std::is_same<T, long int>::value) && (!std::is_same<T, long unsigned int>::value)) || sizeof(T) == 8)) ||  // long int is always serialized as int64_t
+         std::is_same<T, float>::value || std::is_same<T, double>::value
+       };
+};
+
+/*!
+ * Type trait that defines the number of bytes that objects of type T occupy in binary streams
+ * - if this is the same for all objects of type T (value is zero otherwise).
+ *
+ * Output and input stream operators use this to check for sufficient buffer capacity only once
+ * for e.g. a std::pair or a std::tuple of numbers - and once for a whole container of such values.
+ * Ranges of objects with fixed size can be skipped in one step (see tInputStream::SkipValues()).
+ *
+ * May be specialized for user types with a fixed binary size:
+ *
+ *   template <>
+ *   struct FixedSerializedSize<tMyType>
+ *   {
+ *     enum { value = 24 };
+ *   };
+ *
+ * (enum types are not considered, as the size of their binary representation depends on the number of enum constants)
+ */
+template <typename T>
+struct FixedSerializedSize
+{
+  enum { value = std::is_same<T, bool>::value ? 1 :
+                 (std::is_same<T, long int>::value || std::is_same<T, long unsigned int>::value) ? 8 :  // long int is always serialized as int64_t
+                 IsBulkSerializable<T>::value ? sizeof(T) : 0
+       };
+};
+
+template <typename T>
+struct FixedSerializedSize<const T> : FixedSerializedSize<T>
+{};
+
+template <typename T1, typename T2>
+struct FixedSerializedSize<std::pair<T1, T2>>
+{
+  enum { value = (FixedSerializedSize<T1>::value != 0 && FixedSerializedSize<T2>::value != 0) ? (FixedSerializedSize<T1>::value + FixedSerializedSize<T2>::value) : 0 };
+};
+
+template <>
+struct FixedSerializedSize<std::tuple<>>
+{
+  enum { value = 0 };
+};
+
+template <typename T, typename ... TRest>
+struct FixedSerializedSize<std::tuple<T, TRest...>>
+{
+  enum { value = (FixedSerializedSize<T>::value != 0 && (sizeof...(TRest) == 0 || FixedSerializedSize<std::tuple<TRest...>>::value != 0)) ?
+                 (FixedSerializedSize<T>::value + FixedSerializedSize<std::tuple<TRest...>>::value) : 0
+       };
+};
+
+template <typename T, size_t N>
+struct FixedSerializedSize<std::array<T, N>>
+{
+  enum { value = FixedSerializedSize<T>::value * N };
+};
+
 #ifndef __BYTE_ORDER__
 #warning __BYTE_ORDER__ not defined
 #endif
@@ -0,0 +1,138 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/serialization/detail/byte_order.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-16
+ *
+ * Helpers for swapping the byte order of arrays of numbers
+ * (required for bulk (de)serialization on big endian platforms).
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__serialization__detail__byte_order_h__
+#define __rrlib__serialization__detail__byte_order_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <cstdint>
+#include <cstring>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace serialization
+{
+namespace detail
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Function declarations
+//----------------------------------------------------------------------
+
+template <size_t SIZE>
+struct tByteSwap;
+
+template <>
+struct tByteSwap<1>
+{
+  typedef uint8_t tUnsigned;
+  static tUnsigned Swap(tUnsigned value)
+  {
+    return value;
+  }
+};
+
+template <>
+struct tByteSwap<2>
+{
+  typedef uint16_t tUnsigned;
+  static tUnsigned Swap(tUnsigned value)
+  {
+    return __builtin_bswap16(value);
+  }
+};
+
+template <>
+struct tByteSwap<4>
+{
+  typedef uint32_t tUnsigned;
+  static tUnsigned Swap(tUnsigned value)
+  {
+    return __builtin_bswap32(value);
+  }
+};
+
+template <>
+struct tByteSwap<8>
+{
+  typedef uint64_t tUnsigned;
+  static tUnsigned Swap(tUnsigned value)
+  {
+    return __builtin_bswap64(value);
+  }
+};
+
+/*!
+ * Copies array of numbers - reversing the byte order of each number.
+ * The loop is simple enough for compilers to vectorize it (e.g. using SSSE3 or NEON byte shuffles).
+ *
+ * \param source Pointer to first number to copy (no alignment required)
+ * \param destination Pointer to memory to copy numbers to (no alignment required; may be identical to source)
+ * \param count Number of numbers to copy
+ */
+template <typename T>
+inline void SwapByteOrder(const void* source, void* destination, size_t count)
+{
+  typedef typename tByteSwap<sizeof(T)>::tUnsigned tUnsigned;
+  const char* src = static_cast<const char*>(source);
+  char* dest = static_cast<char*>(destination);
+  for (size_t i = 0; i < count; i++)
+  {
+    tUnsigned value;
+    memcpy(&value, src + i * sizeof(T), sizeof(T));
+    value = tByteSwap<sizeof(T)>::Swap(value);
+    memcpy(dest + i * sizeof(T), &value, sizeof(T));
+  }
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
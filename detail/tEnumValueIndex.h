@@ -0,0 +1,151 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/serialization/detail/tEnumValueIndex.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tEnumValueIndex
+ *
+ * \b tEnumValueIndex
+ *
+ * Lookup of enum constants' indices by their values - for enums with non-standard values.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__serialization__detail__tEnumValueIndex_h__
+#define __rrlib__serialization__detail__tEnumValueIndex_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <algorithm>
+#include <vector>
+#include "rrlib/util/tEnumBasedFlags.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace serialization
+{
+namespace detail
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Index of enum constants by value
+/*!
+ * For enums with non-standard values (e.g. explicitly assigned, non-contiguous values),
+ * the binary representation of an enum value is the index of the respective enum constant.
+ * This class looks up this index in O(log n) - using a table sorted by value that is created once per enum type.
+ *
+ * \tparam ENUM Enum type (must have non-standard values)
+ */
+template <typename ENUM>
+class tEnumValueIndex
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*!
+   * \param value Enum value to look up
+   * \param index Contains index of enum constant with the specified value after call (if found)
+   * \return True if an enum constant with the specified value exists
+   */
+  static bool Find(ENUM value, size_t& index)
+  {
+    const std::vector<tEntry>& entries = GetEntries();
+    auto it = std::lower_bound(entries.begin(), entries.end(), static_cast<tValue>(value), [](const tEntry & entry, tValue value)
+    {
+      return entry.first < value;
+    });
+    if (it == entries.end() || it->first != static_cast<tValue>(value))
+    {
+      return false;
+    }
+    index = it->second;
+    return true;
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  typedef typename std::underlying_type<ENUM>::type tValue;
+
+  /*! Enum value and index of enum constant */
+  typedef std::pair<tValue, size_t> tEntry;
+
+  /*!
+   * \return Table with all enum constants sorted by value (created on first call)
+   */
+  static const std::vector<tEntry>& GetEntries()
+  {
+    static const std::vector<tEntry> entries = CreateEntries();
+    return entries;
+  }
+
+  static std::vector<tEntry> CreateEntries()
+  {
+    const make_builder::internal::tEnumStrings& enum_strings = make_builder::internal::GetEnumStrings<ENUM>();
+    assert(enum_strings.non_standard_values);
+    std::vector<tEntry> entries;
+    entries.reserve(enum_strings.size);
+    for (size_t i = 0; i < enum_strings.size; i++)
+    {
+      entries.emplace_back(static_cast<tValue>(static_cast<const ENUM*>(enum_strings.non_standard_values)[i]), i);
+    }
+
+    // stable sort: with multiple constants having the same value, the first one is found
+    std::stable_sort(entries.begin(), entries.end(), [](const tEntry & a, const tEntry & b)
+    {
+      return a.first < b.first;
+    });
+    return entries;
+  }
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
@@ -42,9 +42,15 @@
 //----------------------------------------------------------------------
 // Internal includes with ""
 //----------------------------------------------------------------------
+#include "rrlib/serialization/tChunkedMemoryBuffer.h"
+#include "rrlib/serialization/tCountingSink.h"
+#include "rrlib/serialization/tIndexedContainerReader.h"
 #include "rrlib/serialization/tInputStream.h"
+#include "rrlib/serialization/tLazy.h"
+#include "rrlib/serialization/tMemoryBufferPool.h"
 #include "rrlib/serialization/tOutputStream.h"
 #include "rrlib/serialization/tStackMemoryBuffer.h"
+#include "rrlib/serialization/tStaticOutputStream.h"
 #include "rrlib/serialization/tStringInputStream.h"
 #include "rrlib/serialization/tStringOutputStream.h"
 #include "rrlib/serialization/detail/utility.h"
@@ -166,6 +172,43 @@ void Deserialize(tInputStream& stream, T& t, tDataEncoding enc)
   }
 }
 
+/*!
+ * Determines the size of an object's binary representation
+ * (e.g. to allocate a memory buffer of suitable size before serializing large objects - avoiding repeated reallocation and copying).
+ * For types with fixed serialized size, this is a compile-time constant.
+ * Otherwise, the object is serialized to a tCountingSink.
+ *
+ * \param t Object to determine serialized size of
+ * \param stream Stream that object will be written to (its encoding settings are used - see tOutputStream::CopyEncodingSettings())
+ * \return Number of bytes that serializing the object will write to this stream
+ */
+template <typename T>
+size_t GetSerializedSize(const T& t, const tOutputStream& stream)
+{
+  if (FixedSerializedSize<T>::value != 0)
+  {
+    return FixedSerializedSize<T>::value;
+  }
+  tCountingSink sink;
+  tOutputStream os(sink);
+  os.CopyEncodingSettings(stream);
+  os << t;
+  os.Close();
+  return sink.GetSize();
+}
+
+/*!
+ * Determines the size of an object's binary representation - with default encoding settings
+ *
+ * \param t Object to determine serialized size of
+ * \return Number of bytes that serializing the object will write to a binary output stream with default encoding settings
+ */
+template <typename T>
+size_t GetSerializedSize(const T& t)
+{
+  return GetSerializedSize(t, tOutputStream());
+}
+
 /*!
  * Creates deep copy of serializable object using serialization to and from memory buffer
  *
@@ -0,0 +1,197 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/serialization/tAsyncInputStream.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tAsyncInputStream
+ *
+ * \b tAsyncInputStream
+ *
+ * Binary input stream for data that arrives asynchronously - driven by an event loop or executor.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__serialization__tAsyncInputStream_h__
+#define __rrlib__serialization__tAsyncInputStream_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <algorithm>
+#include "rrlib/util/tNoncopyable.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/serialization/tInputStream.h"
+#include "rrlib/serialization/tReceiveBuffer.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace serialization
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Input stream for asynchronously arriving data
+/*!
+ * Binary input stream for data that arrives asynchronously (e.g. from non-blocking sockets).
+ * No thread blocks while waiting for data: an event loop or executor passes received data
+ * to Append() - and then calls TryRead() to deserialize all objects that have arrived completely.
+ *
+ * If an object has not arrived completely, reading it is suspended: TryRead() returns false and,
+ * once more data has been appended, reading is resumed from the beginning of this object.
+ * The same stream operators are used as with blocking input streams:
+ *
+ *   void OnReadable(int socket)  // called by event loop
+ *   {
+ *     ssize_t received = recv(socket, data, sizeof(data), 0);
+ *     stream.Append(data, received);
+ *     tMessage message;
+ *     while (stream.TryRead(message))
+ *     {
+ *       Process(message);
+ *     }
+ *   }
+ *
+ * Reading is resumed by restoring a checkpoint (see tInputStream::Checkpoint()).
+ * Therefore, objects that arrive in many pieces may be partially deserialized several times.
+ * However, reading is only resumed once the data that was missing in the last attempt has arrived -
+ * including all data up to open skip offset targets (see tNeedMoreDataException::GetRequiredPosition()).
+ */
+class tAsyncInputStream : private util::tNoncopyable
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*!
+   * \param encoding Data type encoding to use when data types from rrlib::rtti are deserialized (optional)
+   * \param integer_encoding Encoding of container sizes, enum indices and numbers read with ReadEncodedNumber (optional)
+   * \param initial_capacity Initial capacity of receive buffer
+   */
+  tAsyncInputStream(tTypeEncoding encoding = tTypeEncoding::LOCAL_UIDS, tIntegerEncoding integer_encoding = tIntegerEncoding::FIXED,
+                    size_t initial_capacity = tReceiveBuffer::cDEFAULT_SIZE) :
+    receive_buffer(initial_capacity),
+    stream(receive_buffer, encoding, integer_encoding),
+    resume_position(0)
+  {}
+
+  /*!
+   * Adds received data
+   *
+   * \param data Pointer to data
+   * \param size Number of bytes
+   */
+  inline void Append(const void* data, size_t size)
+  {
+    receive_buffer.Append(data, size);
+  }
+
+  /*!
+   * \return Wrapped input stream (e.g. for configuration - objects should be read using TryRead())
+   */
+  inline tInputStream& GetStream()
+  {
+    return stream;
+  }
+
+  /*!
+   * Deserializes object - if it has arrived completely.
+   *
+   * \param object Object to deserialize (might be modified, even if false is returned)
+   * \return True, if object was deserialized. False, if more data needs to arrive first.
+   */
+  template <typename T>
+  inline bool TryRead(T& object)
+  {
+    return TryReadUsing([&object](tInputStream & stream)
+    {
+      stream >> object;
+    });
+  }
+
+  /*!
+   * Calls function that reads from stream - if the data it reads has arrived completely.
+   * Function is suspended (aborted) if data is missing - and is called again in the next attempt.
+   *
+   * \param function Function that reads from the stream. Is called with tInputStream& as only argument.
+   * \return True, if function completed. False, if more data needs to arrive first.
+   */
+  template <typename TFunction>
+  bool TryReadUsing(TFunction function)
+  {
+    if (receive_buffer.GetEndPosition() < resume_position || (!stream.MoreDataAvailable()))
+    {
+      return false;
+    }
+    tInputStream::tCheckpoint checkpoint = stream.Checkpoint();
+    try
+    {
+      function(stream);
+    }
+    catch (const tNeedMoreDataException& e)
+    {
+      stream.RestoreCheckpoint(checkpoint);
+      resume_position = std::max(e.GetRequiredPosition(), receive_buffer.GetEndPosition() + 1);
+      return false;
+    }
+    receive_buffer.Discard(stream.GetAbsoluteReadPosition());
+    return true;
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Buffer for received data (retains data of object that is currently read) */
+  tReceiveBuffer receive_buffer;
+
+  /*! Stream that reads from receive buffer */
+  tInputStream stream;
+
+  /*! Reading is not resumed before data up to this absolute position has arrived */
+  int64_t resume_position;
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+
+#endif
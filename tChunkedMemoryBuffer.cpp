@@ -0,0 +1,228 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/serialization/tChunkedMemoryBuffer.cpp
+ *
+ * \author  agent
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#include "rrlib/serialization/tChunkedMemoryBuffer.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <algorithm>
+#include <stdexcept>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/serialization/tOutputStream.h"
+#include "rrlib/serialization/tInputStream.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace serialization
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+const size_t tChunkedMemoryBuffer::cDEFAULT_CHUNK_SIZE;
+
+tChunkedMemoryBuffer::tChunkedMemoryBuffer(size_t chunk_size) :
+  chunk_size(std::max<size_t>(chunk_size, 16)),  // chunks should have at least space for 8+ bytes (in order to avoid assertion)
+  chunks(),
+  used_chunks(1)
+{
+  chunks.emplace_back(this->chunk_size, 0, 0);
+}
+
+tChunkedMemoryBuffer::tChunk& tChunkedMemoryBuffer::AppendChunk(const tChunk& chunk, size_t min_capacity)
+{
+  size_t index = chunk.index + 1;
+  size_t offset = chunk.offset + chunk.size;
+  if (index < chunks.size() && chunks[index].Capacity() >= min_capacity)
+  {
+    chunks[index].offset = offset;
+    chunks[index].size = 0;
+  }
+  else
+  {
+    chunks.erase(chunks.begin() + index, chunks.end());
+    chunks.emplace_back(std::max(chunk_size, min_capacity), index, offset);
+  }
+  used_chunks = index + 1;
+  return chunks[index];
+}
+
+void tChunkedMemoryBuffer::DirectRead(tInputStream& input_stream, tFixedBuffer& buffer, size_t offset, size_t len) const
+{
+  throw std::logic_error("Unsupported - shouldn't be called");
+}
+
+void tChunkedMemoryBuffer::DirectWrite(tOutputStream& output_stream, const tFixedBuffer& buffer, size_t offset, size_t len)
+{
+  throw std::logic_error("Unsupported - shouldn't be called");
+}
+
+void tChunkedMemoryBuffer::Read(tInputStream& input_stream, tBufferInfo& buffer, size_t len) const
+{
+  const tChunk& chunk = GetBufferChunk(buffer);
+  if (chunk.index + 1 >= used_chunks)
+  {
+    throw std::out_of_range("Attempt to read outside of buffer");
+  }
+  const tChunk& next = chunks[chunk.index + 1];
+  if (next.size < len)
+  {
+    throw std::out_of_range("Attempt to read outside of buffer");  // only possible with last chunk - as all others contain at least 8 bytes
+  }
+  buffer.buffer = const_cast<tChunk*>(&next);
+  buffer.position = 0u;
+  buffer.SetRange(0u, next.size);
+}
+
+void tChunkedMemoryBuffer::Reset(tInputStream& input_stream, tBufferInfo& buffer) const
+{
+  buffer.buffer = const_cast<tChunk*>(&chunks[0]);
+  buffer.position = 0u;
+  buffer.SetRange(0u, chunks[0].size);
+}
+
+void tChunkedMemoryBuffer::Reset(tOutputStream& output_stream, tBufferInfo& buffer)
+{
+  Clear();
+  buffer.buffer = &chunks[0];
+  buffer.position = 0u;
+  buffer.SetRange(0u, chunks[0].Capacity());
+}
+
+void tChunkedMemoryBuffer::Seek(tInputStream& input_stream, tBufferInfo& buffer, uint64_t position) const
+{
+  if (position > GetSize())
+  {
+    throw std::out_of_range("Position out of range: " + std::to_string(position));
+  }
+
+  // find last chunk that starts at or before position
+  auto chunk = std::upper_bound(chunks.begin(), chunks.begin() + used_chunks, position, [](uint64_t position, const tChunk & chunk)
+  {
+    return position < chunk.offset;
+  }) - 1;
+  buffer.buffer = const_cast<tChunk*>(&(*chunk));
+  buffer.SetRange(0u, chunk->size);
+  buffer.position = position - chunk->offset;
+}
+
+bool tChunkedMemoryBuffer::Write(tOutputStream& output_stream, tBufferInfo& buffer, int write_size_hint)
+{
+  tChunk& chunk = GetBufferChunk(buffer);
+  UpdateUsedChunks(buffer);
+  if (write_size_hint < 0)
+  {
+    return false;  // manual flush
+  }
+
+  size_t required = static_cast<size_t>(write_size_hint) + 8;
+  if (chunk.Capacity() - chunk.size >= required)
+  {
+    return false;  // e.g. data after marks is written to the same chunk again
+  }
+  if (chunk.size < 8)
+  {
+    // replace chunk with larger one (so that chunks contain at least 8 bytes)
+    tChunk larger_chunk(std::max(chunk_size, chunk.size + required), chunk.index, chunk.offset);
+    larger_chunk.Put(0u, chunk, 0u, buffer.end);  // data after position is kept as well (see tSink::Write())
+    larger_chunk.size = chunk.size;
+    chunk = std::move(larger_chunk);
+    buffer.SetRange(0u, chunk.Capacity());
+    return false;
+  }
+
+  tChunk& next = AppendChunk(chunk, required);
+  buffer.buffer = &next;
+  buffer.position = 0u;
+  buffer.SetRange(0u, next.Capacity());
+  return false;  // previous chunks are kept: skip offset placeholders in them can still be filled in
+}
+
+tOutputStream& operator << (tOutputStream& stream, const tChunkedMemoryBuffer& buffer)
+{
+  stream.WriteEncodedNumber<uint64_t>(buffer.GetSize());
+  for (size_t i = 0; i < buffer.used_chunks; i++)
+  {
+    if (buffer.chunks[i].size)
+    {
+      stream.Write(buffer.chunks[i], 0u, buffer.chunks[i].size);
+    }
+  }
+  return stream;
+}
+
+tInputStream& operator >> (tInputStream& stream, tChunkedMemoryBuffer& buffer)
+{
+  size_t remaining = stream.ReadEncodedNumber<uint64_t>();
+  buffer.Clear();
+  tChunkedMemoryBuffer::tChunk* chunk = &buffer.chunks[0];
+  while (remaining)
+  {
+    if (chunk->size == chunk->Capacity())
+    {
+      chunk = &buffer.AppendChunk(*chunk, 8);
+    }
+    size_t length = std::min(remaining, chunk->Capacity() - chunk->size);
+    stream.ReadFully(*chunk, chunk->size, length);
+    chunk->size += length;
+    remaining -= length;
+  }
+  return stream;
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
@@ -0,0 +1,291 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/serialization/tChunkedMemoryBuffer.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tChunkedMemoryBuffer
+ *
+ * \b tChunkedMemoryBuffer
+ *
+ * Memory buffer that consists of a sequence of chunks.
+ * It grows by appending chunks - so existing contents are never copied.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__serialization__tChunkedMemoryBuffer_h__
+#define __rrlib__serialization__tChunkedMemoryBuffer_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <deque>
+#include "rrlib/util/tNoncopyable.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/serialization/tBufferInfo.h"
+#include "rrlib/serialization/tConstSource.h"
+#include "rrlib/serialization/tDataView.h"
+#include "rrlib/serialization/tFixedBuffer.h"
+#include "rrlib/serialization/tSink.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace serialization
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+class tInputStream;
+class tOutputStream;
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Memory buffer consisting of chunks
+/*!
+ * Memory buffer that can be used as (concurrent) source and as sink - similar to tMemoryBuffer.
+ *
+ * Instead of reallocating and copying its contents when it needs to grow, this buffer
+ * appends another chunk. This is more efficient for large data (e.g. snapshots of
+ * large maps): data is written once, and old and new memory blocks never coexist.
+ * The chunks can be accessed directly (e.g. to write them to a socket or file without
+ * copying them to a contiguous block first).
+ *
+ * Chunks have the size specified in the constructor - unless data written after open
+ * marks needs to be moved to a new chunk and requires more space.
+ * As chunks are never moved, skip offsets are written to the chunk containing the placeholder.
+ * All chunks apart from the last one contain at least 8 bytes, as input streams may require this many bytes
+ * from the next chunk (chunks with less data are replaced with larger ones before another chunk is appended).
+ * Allocated chunks are kept and reused when the buffer is cleared.
+ *
+ * Writing concurrently to reading is not supported.
+ */
+class tChunkedMemoryBuffer : public tConstSource, public tSink, public util::tNoncopyable
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*! Default size of chunks */
+  static const size_t cDEFAULT_CHUNK_SIZE = 65536u;
+
+  /*!
+   * \param chunk_size Size of chunks (in bytes)
+   */
+  tChunkedMemoryBuffer(size_t chunk_size = cDEFAULT_CHUNK_SIZE);
+
+  /*!
+   * Clear buffer (allocated chunks are kept for reuse)
+   */
+  void Clear()
+  {
+    chunks[0].size = 0;
+    used_chunks = 1;
+  }
+
+  /*!
+   * \param index Index of chunk (must be smaller than GetChunkCount())
+   * \return View on used part of chunk (valid until the buffer is written to or cleared)
+   */
+  tDataView GetChunk(size_t index) const
+  {
+    assert(index < used_chunks);
+    return tDataView(chunks[index].GetPointer(), chunks[index].size);
+  }
+
+  /*!
+   * \return Number of chunks that contain data (at least one - which is empty, if the buffer is empty)
+   */
+  size_t GetChunkCount() const
+  {
+    return used_chunks;
+  }
+
+  /*!
+   * \return Size of chunks (in bytes)
+   */
+  size_t GetChunkSize() const
+  {
+    return chunk_size;
+  }
+
+  /*!
+   * \return Buffer size (number of bytes in all chunks)
+   */
+  size_t GetSize() const
+  {
+    const tChunk& last = chunks[used_chunks - 1];
+    return last.offset + last.size;
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  friend tOutputStream& operator << (tOutputStream& stream, const tChunkedMemoryBuffer& buffer);
+  friend tInputStream& operator >> (tInputStream& stream, tChunkedMemoryBuffer& buffer);
+
+  /*! Chunk of memory */
+  struct tChunk : public tFixedBuffer
+  {
+    /*! Index of chunk */
+    size_t index;
+
+    /*! Offset of chunk's first byte in buffer */
+    size_t offset;
+
+    /*! Number of bytes in chunk */
+    size_t size;
+
+    tChunk(size_t capacity, size_t index, size_t offset) :
+      tFixedBuffer(capacity),
+      index(index),
+      offset(offset),
+      size(0)
+    {}
+  };
+
+  /*! Size of chunks */
+  size_t chunk_size;
+
+  /*! Chunks (including allocated chunks that are currently unused; chunks in a deque are not moved when others are added) */
+  std::deque<tChunk> chunks;
+
+  /*!
+   * Number of chunks that contain data.
+   * All of these chunks - apart from the last one - contain at least 8 bytes
+   * (as input streams may require this many bytes when fetching the next buffer).
+   * Only the first chunk may be empty.
+   */
+  size_t used_chunks;
+
+
+  /*!
+   * \param buffer Buffer info that refers to one of this buffer's chunks
+   * \return Chunk that buffer info refers to
+   */
+  static tChunk& GetBufferChunk(const tBufferInfo& buffer)
+  {
+    return static_cast<tChunk&>(*buffer.buffer);
+  }
+
+  /*!
+   * Appends chunk after the specified chunk (reusing an allocated chunk, if it is large enough).
+   * Chunks that previously followed it are discarded.
+   *
+   * \param chunk Current last chunk
+   * \param min_capacity Minimum capacity of new chunk
+   * \return New chunk (empty)
+   */
+  tChunk& AppendChunk(const tChunk& chunk, size_t min_capacity);
+
+  virtual void Close(tInputStream& input_stream, tBufferInfo& buffer) const override
+  {
+    buffer.Reset();
+  }
+
+  virtual void Close(tOutputStream& output_stream, tBufferInfo& buffer) override
+  {
+    buffer.Reset();
+  }
+
+  virtual void DirectRead(tInputStream& input_stream, tFixedBuffer& buffer, size_t offset, size_t len) const override;
+
+  virtual bool DirectReadSupport() const override
+  {
+    return false;
+  }
+
+  virtual void DirectWrite(tOutputStream& output_stream, const tFixedBuffer& buffer, size_t offset, size_t len) override;
+
+  virtual bool DirectWriteSupport() override
+  {
+    return false;
+  }
+
+  virtual void Flush(tOutputStream& output_stream, const tBufferInfo& buffer) override
+  {
+    UpdateUsedChunks(buffer);
+  }
+
+  virtual bool MoreDataAvailable(tInputStream& input_stream, tBufferInfo& buffer) const override
+  {
+    return GetBufferChunk(buffer).index + 1 < used_chunks;
+  }
+
+  virtual void Read(tInputStream& input_stream, tBufferInfo& buffer, size_t len) const override;
+
+  virtual void Reset(tInputStream& input_stream, tBufferInfo& buffer) const override;
+
+  virtual void Reset(tOutputStream& output_stream, tBufferInfo& buffer) override;
+
+  virtual void Seek(tInputStream& input_stream, tBufferInfo& buffer, uint64_t position) const override;
+
+  virtual bool SeekSupport() const override
+  {
+    return true;
+  }
+
+  /*!
+   * Sets size of chunk that output stream writes to - and updates number of used chunks accordingly
+   * (the chunk does not count as used if it is empty - e.g. after data was rolled back to a mark)
+   *
+   * \param buffer Output stream's buffer info that refers to one of this buffer's chunks
+   */
+  void UpdateUsedChunks(const tBufferInfo& buffer)
+  {
+    tChunk& chunk = GetBufferChunk(buffer);
+    chunk.size = buffer.position;
+    used_chunks = (chunk.size || chunk.index == 0) ? chunk.index + 1 : chunk.index;
+  }
+
+  virtual bool Write(tOutputStream& output_stream, tBufferInfo& buffer, int write_size_hint) override;
+};
+
+/*!
+ * Writes chunked memory buffer to stream - in the same format as tMemoryBuffer
+ * (chunks are passed to stream as they are; they are written directly, if the stream's sink supports this)
+ */
+tOutputStream& operator << (tOutputStream& stream, const tChunkedMemoryBuffer& buffer);
+
+tInputStream& operator >> (tInputStream& stream, tChunkedMemoryBuffer& buffer);
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+
+#endif
@@ -46,6 +46,7 @@
 //----------------------------------------------------------------------
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
+#include "rrlib/time/time.h"
 
 //----------------------------------------------------------------------
 // Internal includes with ""
@@ -165,6 +166,35 @@ public:
    * \return Does source support seeking?
    */
   virtual bool SeekSupport() const = 0;
+
+  /*!
+   * Blocks until more data is available or the specified timeout has passed.
+   * (optional operation - see WaitForDataSupport())
+   *
+   * Input streams with a timeout set call this instead of polling MoreDataAvailable().
+   * Sources that are notified when data arrives (e.g. via condition variable or
+   * file descriptor readiness) should implement this - so that data is processed without delay.
+   * Returning early (e.g. on spurious wakeups) is allowed.
+   *
+   * \param input_stream tInputStream that requests operation.
+   * \param buffer Current buffer (managed by source)
+   * \param timeout Maximum time to block
+   * \return Is more data available?
+   */
+  virtual bool WaitForData(tInputStream& input_stream, tBufferInfo& buffer, const rrlib::time::tDuration& timeout) const
+  {
+    return MoreDataAvailable(input_stream, buffer);
+  }
+
+  /*!
+   * \return Does source support blocking until data is available (see WaitForData())?
+   * (otherwise, input streams with a timeout set poll MoreDataAvailable())
+   */
+  virtual bool WaitForDataSupport() const
+  {
+    return false;
+  }
+
 };
 
 //----------------------------------------------------------------------
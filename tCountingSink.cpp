@@ -0,0 +1,107 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/serialization/tCountingSink.cpp
+ *
+ * \author  agent
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#include "rrlib/serialization/tCountingSink.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <algorithm>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace serialization
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+const size_t tCountingSink::cDEFAULT_SIZE;
+
+tCountingSink::tCountingSink(size_t buffer_size) :
+  backend(std::max<size_t>(buffer_size, 16)),
+  size(0)
+{
+}
+
+void tCountingSink::Reset(tOutputStream& output_stream, tBufferInfo& buffer)
+{
+  size = 0;
+  buffer.buffer = &backend;
+  buffer.position = 0u;
+  buffer.SetRange(0u, backend.Capacity());
+}
+
+bool tCountingSink::Write(tOutputStream& output_stream, tBufferInfo& buffer, int write_size_hint)
+{
+  size += buffer.GetWriteLen();
+  if (write_size_hint > 0 && static_cast<size_t>(write_size_hint) > backend.Capacity())
+  {
+    // caller needs this capacity in one piece (old contents - also data after open marks - need not be kept, as they are only counted)
+    tFixedBuffer new_backend(write_size_hint);
+    std::swap(backend, new_backend);
+  }
+  buffer.buffer = &backend;
+  buffer.position = 0u;
+  buffer.SetRange(0u, backend.Capacity());
+
+  // Temp buffer is never shrunk: skip offsets can still be written to placeholder positions (contents are irrelevant)
+  return false;
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
@@ -0,0 +1,149 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/serialization/tCountingSink.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tCountingSink
+ *
+ * \b tCountingSink
+ *
+ * Data sink that discards all data written to it - counting the number of bytes only.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__serialization__tCountingSink_h__
+#define __rrlib__serialization__tCountingSink_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/serialization/tSink.h"
+#include "rrlib/serialization/tBufferInfo.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace serialization
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Data sink that counts bytes only
+/*!
+ * Data sink that discards all data written to it - counting the number of bytes only.
+ * Can be used to determine the size of an object's binary representation
+ * (e.g. in order to allocate a memory buffer of suitable size - see GetSerializedSize()).
+ *
+ * Example usage:
+ *
+ *  using namespace rrlib::serialization;
+ *  tCountingSink sink;
+ *  tOutputStream os(sink);
+ *  os << large_map;
+ *  os.Close();
+ *  tMemoryBuffer buffer(sink.GetSize());
+ *
+ * Large blocks of data are not copied (direct write is supported).
+ * Skip offset placeholders may be written to streams using this sink.
+ */
+class tCountingSink : public tSink
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*! Default size of temp buffer */
+  static const size_t cDEFAULT_SIZE = 4096u;
+
+  /*!
+   * \param buffer_size Size of temp buffer that output streams write to
+   */
+  tCountingSink(size_t buffer_size = cDEFAULT_SIZE);
+
+  /*!
+   * \return Number of bytes written to this sink (complete after stream has been flushed or closed)
+   */
+  inline size_t GetSize() const
+  {
+    return size;
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Temp buffer that output streams write to - contents are discarded */
+  tFixedBuffer backend;
+
+  /*! Number of bytes written to this sink */
+  size_t size;
+
+
+  virtual void Close(tOutputStream& output_stream, tBufferInfo& buffer) override
+  {
+    buffer.Reset();
+  }
+
+  virtual void DirectWrite(tOutputStream& output_stream, const tFixedBuffer& buffer, size_t offset, size_t len) override
+  {
+    size += len;
+  }
+
+  virtual bool DirectWriteSupport() override
+  {
+    return true;
+  }
+
+  virtual void Flush(tOutputStream& output_stream, const tBufferInfo& buffer) override
+  {
+  }
+
+  virtual void Reset(tOutputStream& output_stream, tBufferInfo& buffer) override;
+
+  virtual bool Write(tOutputStream& output_stream, tBufferInfo& buffer, int write_size_hint) override;
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+
+#endif
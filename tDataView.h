@@ -0,0 +1,173 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/serialization/tDataView.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tDataView
+ *
+ * \b tDataView
+ *
+ * Read-only view on a contiguous range of bytes that is owned by someone else
+ * (e.g. a string in an input stream's current buffer - see tInputStream::ReadStringView()).
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__serialization__tDataView_h__
+#define __rrlib__serialization__tDataView_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <cstring>
+#include <string>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace serialization
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Read-only view on contiguous bytes
+/*!
+ * Read-only view on a contiguous range of bytes that is owned by someone else
+ * (similar to std::string_view - which is not available with C++11).
+ * The view does not copy any data. It must not be used after the memory it refers to has become invalid.
+ */
+class tDataView
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  tDataView() :
+    data(NULL),
+    size(0)
+  {}
+
+  /*!
+   * \param data Pointer to first byte
+   * \param size Number of bytes
+   */
+  tDataView(const char* data, size_t size) :
+    data(data),
+    size(size)
+  {}
+
+  const char* begin() const
+  {
+    return data;
+  }
+
+  const char* end() const
+  {
+    return data + size;
+  }
+
+  /*!
+   * \return Pointer to first byte
+   */
+  const char* Data() const
+  {
+    return data;
+  }
+
+  /*!
+   * \return Is view empty?
+   */
+  bool Empty() const
+  {
+    return size == 0;
+  }
+
+  /*!
+   * \return Number of bytes
+   */
+  size_t Size() const
+  {
+    return size;
+  }
+
+  /*!
+   * \return Copy of viewed bytes as std::string
+   */
+  std::string ToString() const
+  {
+    return std::string(data, size);
+  }
+
+  bool operator==(const tDataView& other) const
+  {
+    return size == other.size && (size == 0 || memcmp(data, other.data, size) == 0);
+  }
+  bool operator==(const std::string& other) const
+  {
+    return *this == tDataView(other.data(), other.length());
+  }
+  bool operator==(const char* other) const
+  {
+    return *this == tDataView(other, strlen(other));
+  }
+
+  template <typename T>
+  bool operator!=(const T& other) const
+  {
+    return !(*this == other);
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Pointer to first byte */
+  const char* data;
+
+  /*! Number of bytes */
+  size_t size;
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+
+#endif
@@ -70,8 +70,8 @@ namespace serialization
 //----------------------------------------------------------------------
 // tFileSink constructors
 //----------------------------------------------------------------------
-tFileSink::tFileSink(const std::string &file_path) : tSink(), file_path(file_path),
-  backend(1024)
+tFileSink::tFileSink(const std::string &file_path, size_t buffer_size) : tSink(), file_path(file_path),
+  backend(buffer_size)
 {
   ofstream.exceptions(std::ofstream::failbit | std::ofstream::badbit);
 }
@@ -108,7 +108,7 @@ bool tFileSink::Write(tOutputStream& output_stream, tBufferInfo& buffer, int wri
 {
   RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Write with length ", buffer.GetWriteLen());
 
-  ofstream.write(buffer.buffer->GetPointer(), buffer.GetWriteLen());
+  ofstream.write(buffer.buffer->GetPointer() + buffer.start, buffer.GetWriteLen());
   buffer.position = 0u;
   buffer.SetRange(0u, backend.Capacity());
 
@@ -118,7 +118,7 @@ bool tFileSink::Write(tOutputStream& output_stream, tBufferInfo& buffer, int wri
 void tFileSink::Flush(tOutputStream& output_stream, const tBufferInfo& buffer)
 {
   RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Flush, remaining length ", buffer.GetWriteLen());
-  ofstream.write(buffer.buffer->GetPointer(), buffer.GetWriteLen());
+  ofstream.write(buffer.buffer->GetPointer() + buffer.start, buffer.GetWriteLen());
   ofstream.flush();
 }
 
@@ -67,6 +67,10 @@ namespace serialization
 /*!
  * A data sink that writes binary data to a file.
  *
+ * Data is written to a std::ofstream. For vectored writes (see tSink::WriteVectored()), the default implementation
+ * is sufficient: the stream's file buffer collects the buffered data, and large blocks are passed on together with it
+ * (libstdc++ does this with a single writev() call).
+ *
  * Example usage:
  *
  *  using namespace rrlib::serialization;
@@ -88,8 +92,9 @@ public:
   /**
    * Create a new file sink for the specified file
    * \param file_path path to the file
+   * \param buffer_size the size of the internal buffer
    */
-  tFileSink(const std::string &file_path);
+  tFileSink(const std::string &file_path, size_t buffer_size = 1024);
 
 private:
 
@@ -127,6 +132,18 @@ private:
    */
   virtual void Flush(tOutputStream& output_stream, const tBufferInfo& buffer) override;
 
+  /*!
+   * Forwarded blocks are passed to the file stream separately, whereas copied blocks are written together.
+   * Blocks are therefore only forwarded, when they fill at least half of the buffer.
+   *
+   * \param buffer_capacity Capacity of the stream's current buffer
+   * \return Threshold in bytes
+   */
+  virtual size_t GetDirectWriteThreshold(size_t buffer_capacity) override
+  {
+    return buffer_capacity / 2;
+  }
+
   /*!
    * Reset sink for writing content (again)
    * (may only be supported once - typically the case with streams)
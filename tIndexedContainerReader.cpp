@@ -0,0 +1,105 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/serialization/tIndexedContainerReader.cpp
+ *
+ * \author  agent
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#include "rrlib/serialization/tIndexedContainerReader.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <algorithm>
+#include <stdexcept>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace serialization
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+const size_t tIndexedContainerReader::cTABLE_BLOCK_SIZE;
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+tIndexedContainerReader::tIndexedContainerReader(tInputStream& stream) :
+  stream(stream),
+  offsets(),
+  elements_position(0),
+  end_position(0)
+{
+  uint32_t size = stream.ReadEncodedNumber<uint32_t>();
+  uint32_t table_offset = stream.ReadInt();  // skip offset
+  elements_position = stream.GetAbsoluteReadPosition();
+  stream.Seek(elements_position + table_offset);
+
+  // size is not trusted: offset table is read in blocks - so that memory is only allocated for offsets that are actually present in stream
+  while (offsets.size() < size)
+  {
+    size_t read_offsets = offsets.size();
+    size_t block_size = std::min<size_t>(size - read_offsets, cTABLE_BLOCK_SIZE);
+    offsets.resize(read_offsets + block_size);
+    stream.ReadNumbers(offsets.data() + read_offsets, block_size);
+    for (size_t i = read_offsets; i < offsets.size(); i++)
+    {
+      if (offsets[i] > table_offset || (i > 0 && offsets[i] < offsets[i - 1]))
+      {
+        throw std::runtime_error("Invalid offset table of indexed container");
+      }
+    }
+  }
+  end_position = stream.GetAbsoluteReadPosition();
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
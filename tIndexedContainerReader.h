@@ -0,0 +1,193 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/serialization/tIndexedContainerReader.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tIndexedContainerReader
+ *
+ * \b tIndexedContainerReader
+ *
+ * Provides random access to elements of containers serialized in indexed format.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__serialization__tIndexedContainerReader_h__
+#define __rrlib__serialization__tIndexedContainerReader_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <vector>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/serialization/tInputStream.h"
+#include "rrlib/serialization/tOutputStream.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace serialization
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Random access to elements of indexed containers
+/*!
+ * Provides random access to elements of a container that was written with WriteIndexedContainer().
+ *
+ * Indexed format: container size (encoded number), skip offset to offset table, elements, offset table.
+ * The offset table contains the offset of every element (32 bit; relative to the first element).
+ * It is read on construction. Afterwards, any element can be read by seeking to it directly.
+ * This requires a source that supports seeking (e.g. tMemoryBuffer or tFileSource).
+ */
+class tIndexedContainerReader
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*!
+   * Reads offset table of indexed container at current stream position.
+   * Afterwards, stream is positioned after the container.
+   *
+   * \param stream Stream to read from (must exist as long as this reader is used)
+   * \exception std::runtime_error is thrown if offset table is invalid (reading beyond the end of the source throws as well)
+   */
+  tIndexedContainerReader(tInputStream& stream);
+
+  /*!
+   * \return Absolute stream position after the container (e.g. for reading data that follows the container - see tInputStream::Seek())
+   */
+  int64_t GetEndPosition() const
+  {
+    return end_position;
+  }
+
+  /*!
+   * Reads element with specified index.
+   * Seeks stream to element - stream is positioned after this element afterwards.
+   *
+   * \param index Index of element
+   * \param element Object to deserialize element to
+   * \exception std::out_of_range is thrown if index is out of range
+   */
+  template <typename T>
+  void Read(size_t index, T& element)
+  {
+    stream.Seek(elements_position + offsets.at(index));
+    stream >> element;
+  }
+
+  /*!
+   * \return Number of elements in container
+   */
+  size_t Size() const
+  {
+    return offsets.size();
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Maximum number of offsets that are read (and allocated) at once */
+  static const size_t cTABLE_BLOCK_SIZE = 4096;
+
+  /*! Stream to read from */
+  tInputStream& stream;
+
+  /*! Offsets of elements (relative to first element) */
+  std::vector<uint32_t> offsets;
+
+  /*! Absolute stream position of first element */
+  int64_t elements_position;
+
+  /*! Absolute stream position after container */
+  int64_t end_position;
+};
+
+/*!
+ * Writes container in indexed format (see tIndexedContainerReader).
+ * Writing requires a sink that supports skip offsets (e.g. tMemoryBuffer).
+ *
+ * \param stream Stream to write to
+ * \param container Container to write
+ */
+template <typename TContainer>
+void WriteIndexedContainer(tOutputStream& stream, const TContainer& container)
+{
+  std::vector<uint32_t> offsets;
+  offsets.reserve(container.size());
+  stream.WriteEncodedNumber<uint32_t>(container.size());
+  stream.WriteSkipOffsetPlaceholder();
+  for (auto it = container.begin(); it != container.end(); ++it)
+  {
+    offsets.push_back(stream.GetSkipOffset());
+    stream << *it;
+  }
+  stream.SkipTargetHere();
+  stream.WriteNumbers(offsets.data(), offsets.size());
+}
+
+/*!
+ * Reads complete container that was written in indexed format (see WriteIndexedContainer())
+ *
+ * \param stream Stream to read from
+ * \param container Container to read elements to (needs to be resizable - e.g. std::vector or std::deque)
+ */
+template <typename TContainer>
+void ReadIndexedContainer(tInputStream& stream, TContainer& container)
+{
+  size_t size = stream.ReadEncodedNumber<uint32_t>();
+  stream.ReadSkipOffset();
+  container.resize(size);
+  for (auto it = container.begin(); it != container.end(); ++it)
+  {
+    stream >> *it;
+  }
+  stream.ToSkipTarget();
+  stream.Skip(size * sizeof(uint32_t));  // offset table
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+
+#endif
@@ -68,25 +68,38 @@ namespace serialization
 // Implementation
 //----------------------------------------------------------------------
 
-tInputStream::tInputStream(tTypeEncoding encoding) :
+tInputStream::tInputStream(tTypeEncoding encoding, tIntegerEncoding integer_encoding) :
   source_buffer(),
   boundary_buffer(),
   boundary_buffer_memory(),
   boundary_buffer_backend(boundary_buffer_memory, 14u),
+  window_buffer(),
+  window_buffer_backend(),
   cur_buffer(NULL),
   source(NULL),
   const_source(NULL),
   absolute_read_pos(0),
-  cur_skip_offset_target(-1),
+  skip_offset_targets(),
   closed(false),
   direct_read_support(false),
   timeout(rrlib::time::tDuration::zero()),
   encoding(encoding),
-  custom_encoder(NULL)
+  custom_encoder(NULL),
+  integer_encoding(integer_encoding),
+  packed_bool_vectors(false),
+  string_encoding(tStringEncoding::NULL_TERMINATED)
 {
   boundary_buffer.buffer = &(boundary_buffer_backend);
 }
 
+tInputStream::tCheckpoint tInputStream::Checkpoint() const
+{
+  tCheckpoint checkpoint;
+  checkpoint.position = absolute_read_pos + cur_buffer->position;
+  checkpoint.skip_offset_targets = skip_offset_targets;
+  return checkpoint;
+}
+
 void tInputStream::Close()
 {
   if (!closed)
@@ -103,14 +116,100 @@ void tInputStream::Close()
   closed = true;
 }
 
+void tInputStream::DiscardPassedSkipOffsetTargets()
+{
+  int64_t pos = absolute_read_pos + cur_buffer->position;
+  while ((!skip_offset_targets.empty()) && skip_offset_targets.back() < pos)
+  {
+    skip_offset_targets.pop_back();
+  }
+}
+
+void tInputStream::EnsureContiguous(size_t size)
+{
+  assert((!closed));
+  if (Remaining() < size)
+  {
+    FetchWindow(size);  // (boundary buffer is not suitable, as data is not necessarily read completely)
+  }
+}
+
+void tInputStream::FetchWindow(size_t size)
+{
+  assert((source != NULL || const_source != NULL));
+
+  // move remaining bytes of current buffer to start of window buffer
+  size_t remain = Remaining();
+  if (UsingWindowBuffer())
+  {
+    if (window_buffer_backend.Capacity() < size)
+    {
+      tFixedBuffer new_backend(std::max(size, 2 * window_buffer_backend.Capacity()));
+      window_buffer_backend.Get(window_buffer.position, new_backend, 0u, remain);
+      window_buffer_backend = std::move(new_backend);
+    }
+    else
+    {
+      memmove(window_buffer_backend.GetPointer(), window_buffer_backend.GetPointer() + window_buffer.position, remain);
+    }
+  }
+  else
+  {
+    if (window_buffer_backend.Capacity() < size)
+    {
+      window_buffer_backend = tFixedBuffer(std::max(size, 2 * window_buffer_backend.Capacity()));
+    }
+    cur_buffer->buffer->Get(cur_buffer->position, window_buffer_backend, 0u, remain);
+  }
+  absolute_read_pos += cur_buffer->position;
+  cur_buffer->position = cur_buffer->end;
+
+  // append bytes from source (source_buffer.position is where window data ends)
+  size_t filled = remain;
+  while (filled < size)
+  {
+    if (source_buffer.Remaining() == 0)
+    {
+      ReadFromSource(1u);
+    }
+    size_t length = std::min(size - filled, source_buffer.Remaining());
+    source_buffer.buffer->Get(source_buffer.position, window_buffer_backend, filled, length);
+    source_buffer.position += length;
+    filled += length;
+  }
+  window_buffer.buffer = &window_buffer_backend;
+  window_buffer.SetRange(0u, size);
+  window_buffer.position = 0u;
+  cur_buffer = &(window_buffer);
+}
+
 void tInputStream::FetchNextBytes(size_t min_required2)
 {
   assert((min_required2 <= 8));
   assert((source != NULL || const_source != NULL));
 
+  // are we finished using window buffer?
+  if (UsingWindowBuffer())
+  {
+    if (Remaining() > 0)
+    {
+      FetchWindow(Remaining() + min_required2);
+      return;
+    }
+    absolute_read_pos += static_cast<int64_t>(window_buffer.end) - static_cast<int64_t>(source_buffer.position);
+    cur_buffer = &(source_buffer);
+    EnsureAvailable(min_required2);
+    return;
+  }
+
   // are we finished using boundary buffer?
-  if (UsingBoundaryBuffer() && boundary_buffer.position >= 7)
+  if (UsingBoundaryBuffer())
   {
+    if (boundary_buffer.position < 7)
+    {
+      FetchWindow(Remaining() + min_required2);  // boundary buffer still contains bytes of previous source buffer (e.g. after PeekWindow())
+      return;
+    }
     absolute_read_pos += 7;
     cur_buffer = &(source_buffer);
     EnsureAvailable(min_required2);
@@ -130,36 +229,7 @@ void tInputStream::FetchNextBytes(size_t min_required2)
     cur_buffer = &(boundary_buffer);
   }
 
-  // if we have a timeout set - wait until more data is available
-  // TODO: this doesn't ensure that there are minRequired2 bytes available. However, it should be sufficient in 99.9% of the cases.
-  if (timeout > rrlib::time::tDuration::zero())
-  {
-    rrlib::time::tDuration initial_sleep = std::chrono::milliseconds(20);  // timeout-related
-    rrlib::time::tDuration slept = rrlib::time::tDuration::zero();  // timeout-related
-    while (timeout > rrlib::time::tDuration::zero() && (!(source != NULL ? source->MoreDataAvailable(*this, source_buffer) : const_source->MoreDataAvailable(*this, source_buffer))))
-    {
-      initial_sleep *= 2;
-
-      std::this_thread::sleep_for(initial_sleep);
-
-      slept += initial_sleep;
-      if (slept > timeout)
-      {
-        throw std::runtime_error("Read Timeout");
-      }
-    }
-  }
-
-  // read next block
-  if (source != NULL)
-  {
-    source->Read(*this, source_buffer, min_required2);
-  }
-  else
-  {
-    const_source->Read(*this, source_buffer, min_required2);
-  }
-  assert((source_buffer.Remaining() >= min_required2));
+  ReadFromSource(min_required2);
 
   // (possibly) fill up boundary buffer
   if (remain > 0)
@@ -173,7 +243,7 @@ void tInputStream::FetchNextBytes(size_t min_required2)
 
 bool tInputStream::MoreDataAvailable()
 {
-  if (Remaining() > 0)
+  if (Remaining() > 0 || (cur_buffer != &(source_buffer) && source_buffer.Remaining() > 0))
   {
     return true;
   }
@@ -212,6 +282,72 @@ float tInputStream::ReadFloat()
   return f;
 }
 
+void tInputStream::ReadFromSource(size_t min_required)
+{
+  // if we have a timeout set - wait until more data is available
+  // TODO: this doesn't ensure that there are minRequired2 bytes available. However, it should be sufficient in 99.9% of the cases.
+  if (timeout > rrlib::time::tDuration::zero() && (source != NULL ? source->WaitForDataSupport() : const_source->WaitForDataSupport()))
+  {
+    // block until source signals that data has arrived
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + timeout;
+    rrlib::time::tDuration wait_time = timeout;
+    while (!(source != NULL ? source->WaitForData(*this, source_buffer, wait_time) : const_source->WaitForData(*this, source_buffer, wait_time)))
+    {
+      std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+      if (now >= deadline)
+      {
+        throw std::runtime_error("Read Timeout");
+      }
+      wait_time = std::chrono::duration_cast<rrlib::time::tDuration>(deadline - now);
+    }
+  }
+  else if (timeout > rrlib::time::tDuration::zero())
+  {
+    rrlib::time::tDuration initial_sleep = std::chrono::milliseconds(20);  // timeout-related
+    rrlib::time::tDuration slept = rrlib::time::tDuration::zero();  // timeout-related
+    while (timeout > rrlib::time::tDuration::zero() && (!(source != NULL ? source->MoreDataAvailable(*this, source_buffer) : const_source->MoreDataAvailable(*this, source_buffer))))
+    {
+      initial_sleep *= 2;
+
+      std::this_thread::sleep_for(initial_sleep);
+
+      slept += initial_sleep;
+      if (slept > timeout)
+      {
+        throw std::runtime_error("Read Timeout");
+      }
+    }
+  }
+
+  // read next block
+  try
+  {
+    if (source != NULL)
+    {
+      source->Read(*this, source_buffer, min_required);
+    }
+    else
+    {
+      const_source->Read(*this, source_buffer, min_required);
+    }
+  }
+  catch (const tNeedMoreDataException& e)
+  {
+    // data up to open skip offset targets belongs to the object that is currently read
+    int64_t required_position = e.GetRequiredPosition();
+    for (int64_t target : skip_offset_targets)
+    {
+      required_position = std::max(required_position, target);
+    }
+    if (required_position == e.GetRequiredPosition())
+    {
+      throw;
+    }
+    throw tNeedMoreDataException(required_position);
+  }
+  assert((source_buffer.Remaining() >= min_required));
+}
+
 void tInputStream::ReadFully(tFixedBuffer& bb, size_t off, size_t len)
 {
   while (true)
@@ -226,7 +362,7 @@ void tInputStream::ReadFully(tFixedBuffer& bb, size_t off, size_t len)
     {
       break;
     }
-    if (UsingBoundaryBuffer() || (!direct_read_support))
+    if (UsingBoundaryBuffer() || UsingWindowBuffer() || (!direct_read_support))
     {
       FetchNextBytes(1u);
     }
@@ -240,6 +376,19 @@ void tInputStream::ReadFully(tFixedBuffer& bb, size_t off, size_t len)
   }
 }
 
+tDataView tInputStream::ReadBytesView(size_t size)
+{
+  if (Remaining() >= size)
+  {
+    const char* data = cur_buffer->buffer->GetPointer() + cur_buffer->position;
+    cur_buffer->position += size;
+    return tDataView(data, size);
+  }
+  view_copy.resize(size);
+  ReadFully(view_copy.data(), size);
+  return tDataView(view_copy.data(), size);
+}
+
 std::string tInputStream::ReadLine()
 {
   tStringOutputStream sb;
@@ -255,70 +404,137 @@ std::string tInputStream::ReadLine()
   return sb.ToString();
 }
 
-void tInputStream::ReadSkipOffset()
+void tInputStream::ReadSkipOffset(bool short_skip_offset)
+{
+  DiscardPassedSkipOffsetTargets();
+  int64_t target = absolute_read_pos + cur_buffer->position;
+  if (short_skip_offset)
+  {
+    target += ReadNumber<uint8_t>();
+    target += 1;  // from ReadNumber()
+  }
+  else
+  {
+    target += ReadInt();
+    target += 4;  // from ReadInt()
+  }
+  skip_offset_targets.push_back(target);
+}
+
+uint64_t tInputStream::ReadVarint()
 {
-  cur_skip_offset_target = absolute_read_pos + cur_buffer->position;
-  cur_skip_offset_target += ReadInt();
-  cur_skip_offset_target += 4;  // from readInt()
+  uint64_t result = 0;
+  for (unsigned int shift = 0; shift < 64; shift += 7)
+  {
+    uint8_t b = ReadNumber<uint8_t>();
+    if (shift == 63 && (b & 0x7E))
+    {
+      throw std::runtime_error("Variable-length number exceeds 64 bits");  // 10th byte may only contain the highest bit
+    }
+    result |= static_cast<uint64_t>(b & 0x7F) << shift;
+    if ((b & 0x80) == 0)
+    {
+      return result;
+    }
+  }
+  throw std::runtime_error("Variable-length number is longer than 10 bytes");
 }
 
 std::string tInputStream::ReadString(size_t max_length)
 {
-  std::stringstream string_buffer;
-  ReadString(string_buffer, max_length);
-  return string_buffer.str();
+  std::string result;
+  ReadString(result, max_length);
+  return result;
 }
 
 void tInputStream::ReadString(std::string& string_buffer, size_t max_length)
 {
-  if (string_buffer.length())
+  string_buffer.clear();  // keeps capacity
+  if (string_encoding == tStringEncoding::LENGTH_PREFIXED)
   {
-    size_t max_length_for_buffer = std::min(string_buffer.length() + 1, max_length);
-    char temp_buffer[max_length_for_buffer + 1];
-    size_t read = ReadString(temp_buffer, max_length_for_buffer, false);
-    bool terminated = (temp_buffer[read - 1] == 0);
-    temp_buffer[read] = 0;
-    if (terminated || read == max_length)
+    size_t length = ReadEncodedNumber<uint32_t>();
+    size_t remaining = std::min(length, max_length);
+    string_buffer.reserve(remaining);
+    while (remaining)
     {
-      string_buffer.assign(temp_buffer);
-    }
-    else
-    {
-      std::stringstream string_stream;
-      string_stream << temp_buffer;
-      ReadString(string_stream, max_length - read);
-      string_buffer = string_stream.str();
+      EnsureAvailable(1u);
+      size_t chunk = std::min(remaining, Remaining());
+      string_buffer.append(cur_buffer->buffer->GetPointer() + cur_buffer->position, chunk);
+      cur_buffer->position += chunk;
+      remaining -= chunk;
     }
+    Skip(length - string_buffer.size());
+    return;
   }
-  else
+  while (max_length)
   {
-    string_buffer = ReadString(max_length);
+    EnsureAvailable(1u);
+    size_t length = std::min(max_length, Remaining());
+    const char* start_pointer = cur_buffer->buffer->GetPointer() + cur_buffer->position;
+    const char* terminator = static_cast<const char*>(memchr(start_pointer, 0, length));
+    if (terminator)
+    {
+      string_buffer.append(start_pointer, terminator - start_pointer);
+      cur_buffer->position += (terminator - start_pointer) + 1;
+      return;
+    }
+    string_buffer.append(start_pointer, length);
+    cur_buffer->position += length;
+    max_length -= length;
   }
 }
 
 void tInputStream::ReadString(std::stringstream& string_stream, size_t max_length)
 {
-  const size_t BUFFER_LENGTH = 1024;
-  char temp_buffer[BUFFER_LENGTH + 1];
+  if (string_encoding == tStringEncoding::LENGTH_PREFIXED)
+  {
+    size_t length = ReadEncodedNumber<uint32_t>();
+    size_t remaining = std::min(length, max_length);
+    while (remaining)
+    {
+      EnsureAvailable(1u);
+      size_t chunk = std::min(remaining, Remaining());
+      string_stream.write(cur_buffer->buffer->GetPointer() + cur_buffer->position, chunk);
+      cur_buffer->position += chunk;
+      remaining -= chunk;
+      length -= chunk;
+    }
+    Skip(length);
+    return;
+  }
   while (max_length)
   {
-    size_t max_length_for_buffer = std::min(BUFFER_LENGTH, max_length);
-    size_t read = ReadString(temp_buffer, max_length_for_buffer, false);
-    bool terminated = (temp_buffer[read - 1] == 0);
-    temp_buffer[read] = 0;
-    if (terminated)
+    EnsureAvailable(1u);
+    size_t length = std::min(max_length, Remaining());
+    const char* start_pointer = cur_buffer->buffer->GetPointer() + cur_buffer->position;
+    const char* terminator = static_cast<const char*>(memchr(start_pointer, 0, length));
+    if (terminator)
     {
-      string_stream << temp_buffer;
+      string_stream.write(start_pointer, terminator - start_pointer);
+      cur_buffer->position += (terminator - start_pointer) + 1;
       return;
     }
-    string_stream << temp_buffer;
-
-    max_length -= read;
+    string_stream.write(start_pointer, length);
+    cur_buffer->position += length;
+    max_length -= length;
   }
 }
 
 size_t tInputStream::ReadString(char* buffer, size_t max_length, bool terminate_if_length_exceeded)
 {
+  if (string_encoding == tStringEncoding::LENGTH_PREFIXED)
+  {
+    size_t length = ReadEncodedNumber<uint32_t>();
+    size_t read = std::min(length, (terminate_if_length_exceeded && max_length) ? (max_length - 1) : max_length);
+    ReadFully(buffer, read);
+    Skip(length - read);
+    if (read < max_length)
+    {
+      buffer[read] = 0;
+      return read + 1;
+    }
+    return read;
+  }
   size_t read = 0;
   while (max_length)
   {
@@ -351,6 +567,39 @@ size_t tInputStream::ReadString(char* buffer, size_t max_length, bool terminate_
   return read;
 }
 
+tDataView tInputStream::ReadStringView()
+{
+  if (string_encoding == tStringEncoding::LENGTH_PREFIXED)
+  {
+    return ReadBytesView(ReadEncodedNumber<uint32_t>());
+  }
+  EnsureAvailable(1u);
+  const char* start_pointer = cur_buffer->buffer->GetPointer() + cur_buffer->position;
+  const char* terminator = static_cast<const char*>(memchr(start_pointer, 0, Remaining()));
+  if (terminator)
+  {
+    cur_buffer->position += (terminator - start_pointer) + 1;
+    return tDataView(start_pointer, terminator - start_pointer);
+  }
+
+  // string crosses buffer boundary: copy it
+  view_copy.clear();
+  while (true)
+  {
+    view_copy.insert(view_copy.end(), start_pointer, start_pointer + Remaining());
+    cur_buffer->position = cur_buffer->end;
+    FetchNextBytes(1u);
+    start_pointer = cur_buffer->buffer->GetPointer() + cur_buffer->position;
+    terminator = static_cast<const char*>(memchr(start_pointer, 0, Remaining()));
+    if (terminator)
+    {
+      view_copy.insert(view_copy.end(), start_pointer, terminator);
+      cur_buffer->position += (terminator - start_pointer) + 1;
+      return tDataView(view_copy.data(), view_copy.size());
+    }
+  }
+}
+
 void tInputStream::Reset()
 {
   if (source != NULL)
@@ -367,6 +616,7 @@ void tInputStream::Reset()
   }
   cur_buffer = &(source_buffer);
   absolute_read_pos = 0;
+  skip_offset_targets.clear();
 }
 
 void tInputStream::Reset(const tConstSource& source)
@@ -385,12 +635,32 @@ void tInputStream::Reset(tSource& source)
   Reset();
 }
 
+void tInputStream::RestoreCheckpoint(const tCheckpoint& checkpoint)
+{
+  // let source provide buffer (current buffer might be the boundary buffer)
+  if (source && source->SeekSupport())
+  {
+    source->Seek(*this, source_buffer, checkpoint.position);
+  }
+  else if (const_source && const_source->SeekSupport())
+  {
+    const_source->Seek(*this, source_buffer, checkpoint.position);
+  }
+  else
+  {
+    throw std::runtime_error("Source does not support seeking");
+  }
+  cur_buffer = &source_buffer;
+  absolute_read_pos = checkpoint.position - cur_buffer->position;
+  skip_offset_targets = checkpoint.skip_offset_targets;
+}
+
 void tInputStream::Seek(int64_t position)
 {
   int64_t offset = position - this->absolute_read_pos;
   if ((source && source->SeekSupport()) || (const_source && const_source->SeekSupport()))
   {
-    if (offset >= 0 && static_cast<size_t>(offset) < this->cur_buffer->Capacity() && Remaining()) // we need to check Remaining(), because a DirectRead may have modified absolute_read_pos
+    if (offset >= 0 && (!UsingBoundaryBuffer()) && this->cur_buffer->start + offset <= this->cur_buffer->end && Remaining()) // we need to check Remaining(), because a DirectRead may have modified absolute_read_pos
     {
       // goal position lies in the current buffer, read it from there
       this->cur_buffer->position = this->cur_buffer->start + offset;
@@ -440,23 +710,34 @@ void tInputStream::Skip(size_t n)
 
 void tInputStream::SkipString()
 {
-  // TODO: optimize
+  if (string_encoding == tStringEncoding::LENGTH_PREFIXED)
+  {
+    Skip(ReadEncodedNumber<uint32_t>());
+    return;
+  }
   while (true)
   {
-    int8_t c = ReadByte();
-    if (c == 0)
+    EnsureAvailable(1u);
+    const char* start_pointer = cur_buffer->buffer->GetPointer() + cur_buffer->position;
+    const char* terminator = static_cast<const char*>(memchr(start_pointer, 0, Remaining()));
+    if (terminator)
     {
-      break;
+      cur_buffer->position += (terminator - start_pointer) + 1;
+      return;
     }
+    cur_buffer->position = cur_buffer->end;
   }
 }
 
 void tInputStream::ToSkipTarget()
 {
+  DiscardPassedSkipOffsetTargets();
+  assert(!skip_offset_targets.empty());
   int64_t pos = cur_buffer->position;
-  assert((cur_skip_offset_target >= absolute_read_pos + pos));
-  Skip(static_cast<size_t>((cur_skip_offset_target - absolute_read_pos - pos)));
-  cur_skip_offset_target = 0;
+  int64_t target = skip_offset_targets.back();
+  skip_offset_targets.pop_back();
+  assert((target >= absolute_read_pos + pos));
+  Skip(static_cast<size_t>((target - absolute_read_pos - pos)));
 }
 
 //----------------------------------------------------------------------
@@ -47,6 +47,7 @@
 //----------------------------------------------------------------------
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
+#include <vector>
 #include "rrlib/util/tNoncopyable.h"
 #include "rrlib/time/time.h"
 #include "rrlib/util/tEnumBasedFlags.h"
@@ -57,8 +58,10 @@
 #include "rrlib/serialization/definitions.h"
 #include "rrlib/serialization/tBufferInfo.h"
 #include "rrlib/serialization/tConstSource.h"
+#include "rrlib/serialization/tDataView.h"
 #include "rrlib/serialization/tSource.h"
 #include "rrlib/serialization/tTypeEncoder.h"
+#include "rrlib/serialization/detail/byte_order.h"
 
 //----------------------------------------------------------------------
 // Namespace declaration
@@ -102,11 +105,37 @@ class tInputStream : private util::tNoncopyable
 //----------------------------------------------------------------------
 public:
 
+  /*!
+   * Stream position and state that the stream can be restored to (see Checkpoint())
+   */
+  class tCheckpoint
+  {
+    friend class tInputStream;
+
+    /*! Absolute position in stream */
+    int64_t position;
+
+    /*! Skip offset targets at this position */
+    std::vector<int64_t> skip_offset_targets;
+
+  public:
+
+    /*!
+     * \return Absolute position in stream
+     */
+    int64_t GetPosition() const
+    {
+      return position;
+    }
+  };
+
   /*!
    * \param source Source to read from
    * \param encoding Data type encoding to use when data types from rrlib::rtti are deserialized (optional)
+   * \param integer_encoding Encoding of container sizes, enum indices and numbers read with ReadEncodedNumber (optional)
    */
-  tInputStream(tSource& source, tTypeEncoding encoding = tTypeEncoding::LOCAL_UIDS) : tInputStream(encoding)
+  tInputStream(tSource& source, tTypeEncoding encoding = tTypeEncoding::LOCAL_UIDS, tIntegerEncoding integer_encoding = tIntegerEncoding::FIXED) :
+    tInputStream(encoding, integer_encoding)
   {
     Reset(source);
   }
@@ -114,24 +143,26 @@ public:
   /*!
    * \param source Source to read from
    * \param encoder Custom type encoder to use when data types from rrlib::rtti are deserialized
+   * \param integer_encoding Encoding of container sizes, enum indices and numbers read with ReadEncodedNumber (optional)
    */
-  tInputStream(tSource& source, tTypeEncoder& encoder) : tInputStream(encoder)
+  tInputStream(tSource& source, tTypeEncoder& encoder, tIntegerEncoding integer_encoding = tIntegerEncoding::FIXED) : tInputStream(encoder, integer_encoding)
   {
     Reset(source);
   }
 
   /*!
-   * \copydoc tInputStream::tInputStream(tSource&,tTypeEncoding)
+   * \copydoc tInputStream::tInputStream(tSource&,tTypeEncoding,tIntegerEncoding)
    */
-  tInputStream(const tConstSource& source, tTypeEncoding encoding = tTypeEncoding::LOCAL_UIDS) : tInputStream(encoding)
+  tInputStream(const tConstSource& source, tTypeEncoding encoding = tTypeEncoding::LOCAL_UIDS, tIntegerEncoding integer_encoding = tIntegerEncoding::FIXED) :
+    tInputStream(encoding, integer_encoding)
   {
     Reset(source);
   }
 
   /*!
-   * \copydoc tInputStream::tInputStream(tSource&,tTypeEncoder&)
+   * \copydoc tInputStream::tInputStream(tSource&,tTypeEncoder&,tIntegerEncoding)
    */
-  tInputStream(const tConstSource& source, tTypeEncoder& encoder) : tInputStream(encoder)
+  tInputStream(const tConstSource& source, tTypeEncoder& encoder, tIntegerEncoding integer_encoding = tIntegerEncoding::FIXED) : tInputStream(encoder, integer_encoding)
   {
     Reset(source);
   }
@@ -140,15 +171,17 @@ public:
    * Note: Reset() with a source needs to be called, before data can be read.
    *
    * \param encoding Data type encoding to use when data types from rrlib::rtti are deserialized (optional)
+   * \param integer_encoding Encoding of container sizes, enum indices and numbers read with ReadEncodedNumber (optional)
    */
-  tInputStream(tTypeEncoding encoding = tTypeEncoding::LOCAL_UIDS);
+  tInputStream(tTypeEncoding encoding = tTypeEncoding::LOCAL_UIDS, tIntegerEncoding integer_encoding = tIntegerEncoding::FIXED);
 
   /*!
    * Note: Reset() with a source needs to be called, before data can be read.
    *
    * \param encoder Custom type encoder to use when data types from rrlib::rtti are deserialized
+   * \param integer_encoding Encoding of container sizes, enum indices and numbers read with ReadEncodedNumber (optional)
    */
-  tInputStream(tTypeEncoder& encoder) : tInputStream(tTypeEncoding::CUSTOM)
+  tInputStream(tTypeEncoder& encoder, tIntegerEncoding integer_encoding = tIntegerEncoding::FIXED) : tInputStream(tTypeEncoding::CUSTOM, integer_encoding)
   {
     custom_encoder = &encoder;
   }
@@ -158,11 +191,50 @@ public:
     Close();
   }
 
+
+  /*!
+   * Creates checkpoint at current position.
+   * If reading fails - e.g. because a non-blocking source throws a tNeedMoreDataException - the stream
+   * can be restored to this checkpoint (see RestoreCheckpoint()) in order to retry reading later.
+   *
+   * \return Checkpoint
+   */
+  tCheckpoint Checkpoint() const;
+
   /*!
    * In case of source change: Cleanup
    */
   void Close();
 
+  /*!
+   * Ensures that the binary representation of an object of type T can be read from the current buffer
+   * with a single check - if T has a fixed serialized size (see FixedSerializedSize).
+   * Does nothing for other types.
+   */
+  template <typename T>
+  inline void EnsureAvailableFixedSize()
+  {
+    enum { cSIZE = FixedSerializedSize<T>::value };
+    if (cSIZE > 8)
+    {
+      EnsureContiguous(cSIZE);  // larger than boundary buffer
+    }
+    else if (cSIZE > 0)
+    {
+      EnsureAvailable(cSIZE);
+    }
+  }
+
+  /*!
+   * Ensures that the specified number of bytes can be read from the current buffer
+   * (so that e.g. ReadBytesView() returns a view without copying).
+   * Only if these bytes cross the boundary of the source's buffers, they are copied to a
+   * separate window buffer, which grows as required.
+   *
+   * \param size Number of bytes
+   */
+  void EnsureContiguous(size_t size);
+
   /*!
    * \return Number of bytes ever read from this stream
    */
@@ -195,6 +267,30 @@ public:
     return encoding;
   }
 
+  /*!
+   * \return Encoding of container sizes, enum indices and numbers read with ReadEncodedNumber
+   */
+  tIntegerEncoding GetIntegerEncoding() const
+  {
+    return integer_encoding;
+  }
+
+  /*!
+   * \return Are std::vector<bool> read in bit-packed format (8 elements per byte)?
+   */
+  bool GetPackedBoolVectors() const
+  {
+    return packed_bool_vectors;
+  }
+
+  /*!
+   * \return Encoding of strings read with ReadString
+   */
+  tStringEncoding GetStringEncoding() const
+  {
+    return string_encoding;
+  }
+
   /*!
    * \return Is further data available?
    */
@@ -205,6 +301,20 @@ public:
    */
   int8_t Peek();
 
+  /*!
+   * Provides the next bytes in the stream as one contiguous block - without forwarding read position
+   * (e.g. to decode a fixed-layout header or to run a decode kernel on raw memory; Skip() the bytes afterwards).
+   * See EnsureContiguous() regarding costs.
+   *
+   * \param size Number of bytes
+   * \return Pointer to the next 'size' bytes. Valid until the next operation on this stream that reads beyond them.
+   */
+  const char* PeekWindow(size_t size)
+  {
+    EnsureContiguous(size);
+    return cur_buffer->buffer->GetPointer() + cur_buffer->position;
+  }
+
   /*!
    * \return boolean value (byte is read from stream and compared against zero)
    */
@@ -223,6 +333,38 @@ public:
    */
   double ReadDouble();
 
+  /*!
+   * Read integer that was written with tOutputStream::WriteEncodedNumber<T>()
+   * - using the integer encoding of this stream (fixed size or variable length; see tIntegerEncoding).
+   *
+   * \return Integer read from stream
+   * \exception std::runtime_error is thrown if a variable-length number does not fit into T
+   */
+  template <typename T>
+  T ReadEncodedNumber()
+  {
+    static_assert(std::is_integral<T>::value, "Only integral types are supported");
+    if (integer_encoding == tIntegerEncoding::FIXED)
+    {
+      return ReadNumber<T>();
+    }
+    uint64_t value = ReadVarint();
+    if (std::is_signed<T>::value)
+    {
+      int64_t signed_value = static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);  // zigzag decoding
+      if (static_cast<int64_t>(static_cast<T>(signed_value)) != signed_value)
+      {
+        throw std::runtime_error("Encoded number out of range");
+      }
+      return static_cast<T>(signed_value);
+    }
+    if (static_cast<uint64_t>(static_cast<T>(value)) != value)
+    {
+      throw std::runtime_error("Encoded number out of range");
+    }
+    return static_cast<T>(value);
+  }
+
   /*!
    * \return Enum value
    */
@@ -249,6 +391,10 @@ public:
     {
       enum_index = ReadByte();
     }
+    else if (integer_encoding == tIntegerEncoding::VARIABLE)
+    {
+      enum_index = ReadVarint();
+    }
     else if (enum_strings_dimension <= 0x10000)
     {
       enum_index = ReadShort();
@@ -305,6 +451,18 @@ public:
    */
   void ReadFully(tFixedBuffer& buffer, size_t offset, size_t length);
 
+  /*!
+   * Reads the specified number of bytes without copying them - if possible.
+   * If the bytes are located in the current buffer, the returned view points to this buffer directly.
+   * Otherwise (the bytes cross a buffer boundary), they are copied to an internal buffer of this stream and the view points there.
+   * In both cases, the view is only valid until the next read operation that fetches data from the source
+   * or until the next call to ReadBytesView() or ReadStringView().
+   *
+   * \param size Number of bytes to read
+   * \return View on bytes read
+   */
+  tDataView ReadBytesView(size_t size);
+
   /*!
    * \return 32 bit integer
    */
@@ -358,13 +516,49 @@ public:
     return t;
   }
 
+  /*!
+   * Reads array of numbers from stream - taking care of endianness.
+   * This is much more efficient than calling ReadNumber() for every value:
+   * The whole array is read with a single ReadFully() call
+   * (on big endian platforms, byte order is swapped afterwards).
+   *
+   * \param values Pointer to first number
+   * \param count Number of numbers to read
+   */
+  template <typename T>
+  void ReadNumbers(T* values, size_t count)
+  {
+    static_assert(IsBulkSerializable<T>::value, "Only supported for bulk serializable types");
+    if (count == 0)
+    {
+      return;
+    }
+    ReadFully(values, count * sizeof(T));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    if (std::is_integral<T>::value && sizeof(T) > 1)
+    {
+      detail::SwapByteOrder<T>(values, values, count);
+    }
+#endif
+  }
+
   /*!
    * Read "skip offset" at current position and store it internally
+   *
+   * Skip offsets may be nested: targets are kept on a stack until ToSkipTarget() is called
+   * (which should also be called after reading a block completely - the innermost first).
+   * Targets that the stream has already moved beyond are discarded automatically.
+   * A target at the current position is not discarded, as it may not have been moved to yet.
+   * Therefore, if a nested block ends where its enclosing block ends (e.g. an empty block at the end),
+   * ToSkipTarget() must be called for the nested block before it is called for the enclosing block.
+   *
+   * \param short_skip_offset Was a short (one byte) skip offset placeholder written? (see tOutputStream::WriteSkipOffsetPlaceholder)
    */
-  void ReadSkipOffset();
+  void ReadSkipOffset(bool short_skip_offset = false);
 
   /*!
-   * Read null-terminated string (8 Bit Characters - Suited for ASCII). Stops at null-termination or specified length.
+   * Read string (8 Bit Characters - Suited for ASCII). Stops at null-termination or specified length.
+   * (Length-prefixed strings are always consumed completely - characters exceeding the specified length are skipped)
    *
    * \param length Maximum length of string to read (including possible termination character)
    * \return String
@@ -372,21 +566,32 @@ public:
   std::string ReadString(size_t max_length = std::string::npos);
 
   /*!
-   * Read null-terminated string (8 Bit Characters - Suited for ASCII). Stops at null-termination or specified length.
+   * Read string (8 Bit Characters - Suited for ASCII). Stops at null-termination or specified length.
+   * (Length-prefixed strings are always consumed completely - characters exceeding the specified length are skipped)
    *
-   * \param string_stream String buffer to write string to. Is cleared before writing to it.
+   * \param string_buffer String buffer to write string to. Is cleared before writing to it.
+   *                      Its capacity is reused: no memory is allocated, if the string fits.
    * \param length Maximum length of string to read (including possible termination character)
    */
   void ReadString(std::string& string_buffer, size_t max_length = std::string::npos);
 
   /*!
-   * Read null-terminated string (8 Bit Characters - Suited for ASCII). Stops at null-termination or specified length.
+   * Read string (8 Bit Characters - Suited for ASCII). Stops at null-termination or specified length.
+   * (Length-prefixed strings are always consumed completely - characters exceeding the specified length are skipped)
    *
    * \param string_stream String stream to write string to. Stream is cleared before writing to it.
    * \param length Maximum length of string to read (including possible termination character)
    */
   void ReadString(std::stringstream& string_stream, size_t max_length = std::string::npos);
 
+  /*!
+   * Reads string (8 Bit Characters - Suited for ASCII) without copying it - if possible
+   * (see ReadBytesView() regarding validity of the returned view).
+   *
+   * \return View on string (without null-termination character or length prefix)
+   */
+  tDataView ReadStringView();
+
   /*!
    * Read string (8 Bit Characters - Suited for ASCII). Stops at null-termination or length BUFFER_SIZE.
    *
@@ -411,6 +616,14 @@ public:
    */
   size_t ReadString(char* buffer, size_t max_length, bool terminate_if_length_exceeded);
 
+  /*!
+   * Read unsigned integer in variable-length LEB128 format (see tOutputStream::WriteVarint)
+   *
+   * \return Integer read from stream
+   * \exception std::runtime_error is thrown if number is longer than 10 bytes or does not fit into 64 bits
+   */
+  uint64_t ReadVarint();
+
   /*!
    * \return unsigned 1 byte integer
    */
@@ -458,6 +671,15 @@ public:
    */
   void Reset(tSource& source);
 
+  /*!
+   * Restores stream to checkpoint: position and skip offsets are set to what they were when the checkpoint was created.
+   * Source must support seeking and must still provide data at the checkpoint's position (see e.g. tReceiveBuffer).
+   *
+   * \param checkpoint Checkpoint created with Checkpoint()
+   * \exception std::runtime_error is thrown if source does not support seeking
+   */
+  void RestoreCheckpoint(const tCheckpoint& checkpoint);
+
   /*!
    * Seek to specified absolute position in the stream
    *
@@ -473,6 +695,37 @@ public:
   void Seek(int64_t position);
 
   /*!
+   * \param integer_encoding Encoding of container sizes, enum indices and numbers read with ReadEncodedNumber
+   * (Must match setting of output stream that wrote the data)
+   */
+  void SetIntegerEncoding(tIntegerEncoding integer_encoding)
+  {
+    this->integer_encoding = integer_encoding;
+  }
+
+  /*!
+   * \param packed_bool_vectors Read std::vector<bool> in bit-packed format (8 elements per byte)?
+   * (Disabled by default. Must match setting of output stream that wrote the data - see tOutputStream::SetPackedBoolVectors)
+   */
+  void SetPackedBoolVectors(bool packed_bool_vectors)
+  {
+    this->packed_bool_vectors = packed_bool_vectors;
+  }
+
+  /*!
+   * \param string_encoding Encoding of strings read with ReadString
+   * (Null-terminated by default. Must match setting of output stream that wrote the data - see tOutputStream::SetStringEncoding)
+   */
+  void SetStringEncoding(tStringEncoding string_encoding)
+  {
+    this->string_encoding = string_encoding;
+  }
+
+  /*!
+   * With a timeout set, the stream blocks on the source until more data is available (see tSource::WaitForData()) -
+   * or polls the source with increasing intervals, if it does not support this.
+   * A std::runtime_error is thrown, if no data arrives in time.
+   *
    * \param timeout for blocking calls (<= 0 when disabled)
    */
   inline void SetTimeout(const rrlib::time::tDuration& timeout)
@@ -486,12 +739,36 @@ public:
   void Skip(size_t n);
 
   /*!
-   * Skips null-terminated string (8 Bit Characters)
+   * Skips the binary representations of the specified number of objects of type T.
+   * If T has a fixed serialized size (see FixedSerializedSize), all of them are skipped in one step.
+   * Otherwise, they are deserialized one by one.
+   *
+   * \param count Number of objects to skip
+   */
+  template <typename T>
+  void SkipValues(size_t count)
+  {
+    if (FixedSerializedSize<T>::value != 0)
+    {
+      Skip(count * FixedSerializedSize<T>::value);
+      return;
+    }
+    T value = T();
+    for (size_t i = 0; i < count; i++)
+    {
+      *this >> value;
+    }
+  }
+
+  /*!
+   * Skips string (8 Bit Characters)
+   * (with length-prefixed strings, this does not need to look at the string's characters)
    */
   void SkipString();
 
   /*!
    * Move to target of last read skip offset
+   * (with nested skip offsets, the innermost target that has not been moved to yet)
    */
   void ToSkipTarget();
 
@@ -515,7 +792,16 @@ private:
   /*! Actual boundary buffer backend - symmetric layout: 7 bit old bytes - 7 bit new bytes */
   tFixedBuffer boundary_buffer_backend;
 
-  /*! Current buffer - either sourceBuffer or boundary buffer */
+  /*! Buffer for contiguous windows that cross buffer boundaries (see EnsureContiguous()) */
+  tBufferInfo window_buffer;
+
+  /*! Backend of window buffer (grows as required) */
+  tFixedBuffer window_buffer_backend;
+
+  /*! Copies of data that was requested via ReadBytesView() or ReadStringView() and crossed a buffer boundary */
+  std::vector<char> view_copy;
+
+  /*! Current buffer - either sourceBuffer, boundary buffer or window buffer */
   tBufferInfo* cur_buffer;
 
   /*! Manager that handles, where the data blocks come from etc. */
@@ -530,8 +816,8 @@ private:
    */
   int64_t absolute_read_pos;
 
-  /*! (Absolute) skip offset target - if one has been read - otherwise -1 */
-  int64_t cur_skip_offset_target;
+  /*! Stack of (absolute) skip offset targets that have been read and not moved to yet (innermost last) */
+  std::vector<int64_t> skip_offset_targets;
 
   /*! Has stream/source been closed? */
   bool closed;
@@ -548,6 +834,15 @@ private:
   /*! Custom type encoder */
   tTypeEncoder* custom_encoder;
 
+  /*! Encoding of container sizes, enum indices and numbers read with ReadEncodedNumber */
+  tIntegerEncoding integer_encoding;
+
+  /*! Read std::vector<bool> in bit-packed format? */
+  bool packed_bool_vectors;
+
+  /*! Encoding of strings read with ReadString */
+  tStringEncoding string_encoding;
+
 
   /*!
    * Ensures that the specified number of bytes is available for reading
@@ -572,6 +867,26 @@ private:
    */
   void FetchNextBytes(size_t min_required);
 
+  /*!
+   * Copies the next bytes to window buffer and makes it the current buffer
+   *
+   * \param size Number of bytes that window buffer needs to contain
+   */
+  void FetchWindow(size_t size);
+
+  /*!
+   * Lets source read next block to source buffer - waiting for data, if a timeout is set
+   *
+   * \param min_required Minimum number of bytes to read
+   */
+  void ReadFromSource(size_t min_required);
+
+  /*!
+   * Discards skip offset targets that the stream has already moved beyond
+   * (targets at the current position are kept - see ReadSkipOffset())
+   */
+  void DiscardPassedSkipOffsetTargets();
+
   /*!
    * \return Is current buffer currently set to boundaryBuffer?
    */
@@ -579,6 +894,14 @@ private:
   {
     return cur_buffer->buffer == boundary_buffer.buffer;
   }
+
+  /*!
+   * \return Is current buffer currently set to window buffer?
+   */
+  inline bool UsingWindowBuffer()
+  {
+    return cur_buffer == &window_buffer;
+  }
 };
 
 // stream operators for various standard types
@@ -698,6 +1021,7 @@ inline tInputStream& operator>> (tInputStream& stream, util::tEnumBasedFlags<TFl
 template <typename T1, typename T2>
 inline tInputStream& operator>> (tInputStream& stream, std::pair<T1, T2>& pair)
 {
+  stream.EnsureAvailableFixedSize<std::pair<T1, T2>>();
   stream >> pair.first >> pair.second;
   return stream;
 }
@@ -721,11 +1045,46 @@ struct tTupleDeserializer < -1, TArgs... >
   {
   }
 };
+
+/*!
+ * Reads array of bulk-serializable values from stream (see tInputStream::ReadNumbers()).
+ *
+ * \param stream Stream to read from
+ * \param values Pointer to first value
+ * \param count Number of values to read
+ */
+template <typename T>
+inline void ReadBulk(tInputStream& stream, T* values, size_t count)
+{
+  stream.ReadNumbers(values, count);
+}
+
+template <typename T, bool BULK_SERIALIZABLE = IsBulkSerializable<T>::value>
+struct tArrayDeserializer
+{
+  static void DeserializeArray(tInputStream& stream, T* values, size_t count)
+  {
+    for (size_t i = 0; i < count; i++)
+    {
+      stream >> values[i];
+    }
+  }
+};
+
+template <typename T>
+struct tArrayDeserializer<T, true>
+{
+  static void DeserializeArray(tInputStream& stream, T* values, size_t count)
+  {
+    ReadBulk(stream, values, count);
+  }
+};
 } // namespace internal
 
 template <typename ... TArgs>
 inline tInputStream& operator>> (tInputStream& stream, std::tuple<TArgs...>& tuple)
 {
+  stream.EnsureAvailableFixedSize<std::tuple<TArgs...>>();
   internal::tTupleDeserializer < static_cast<int>(std::tuple_size<std::tuple<TArgs...>>::value) - 1, TArgs... >::DeserializeTuple(stream, tuple);
   return stream;
 }
@@ -733,10 +1092,7 @@ inline tInputStream& operator>> (tInputStream& stream, std::tuple<TArgs...>& tup
 template <typename T, size_t N>
 inline tInputStream& operator>> (tInputStream& stream, std::array<T, N>& array)
 {
-  for (T & element : array)
-  {
-    stream >> element;
-  }
+  internal::tArrayDeserializer<T>::DeserializeArray(stream, array.data(), N);
   return stream;
 }
 
@@ -0,0 +1,301 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/serialization/tLazy.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tLazy
+ *
+ * \b tLazy
+ *
+ * Wrapper for values that are deserialized lazily - on first access.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__serialization__tLazy_h__
+#define __rrlib__serialization__tLazy_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <vector>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/serialization/tInputStream.h"
+#include "rrlib/serialization/tMemoryBuffer.h"
+#include "rrlib/serialization/tMemoryBufferPool.h"
+#include "rrlib/serialization/tOutputStream.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace serialization
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Lazily deserialized value
+/*!
+ * Wrapper for values of type T that are deserialized lazily.
+ *
+ * In binary streams, the value is preceded by its size in bytes (a 4 byte integer - compatible with tInputStream::ReadSkipOffset()).
+ * When a tLazy<T> is deserialized, only this byte range is copied. The value is decoded on first access (Get()).
+ * This is useful for large messages of which only some fields are accessed.
+ * If the value is serialized again without having been modified, the bytes are written as they are.
+ * Otherwise, it is serialized to a temporary buffer first (obtained from a tMemoryBufferPool), as the size must be written before the value.
+ *
+ * Encoding settings of the input stream (type encoding, integer encoding, packed bool vectors) are used for decoding later.
+ * With a custom type encoder, the encoder must still exist when the value is decoded.
+ *
+ * Get() modifies internal state. Therefore, objects of this class may not be accessed concurrently (even via const methods).
+ *
+ * \tparam T Type of wrapped value (must be binary serializable and default-constructible)
+ */
+template <typename T>
+class tLazy
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  tLazy() :
+    value(),
+    decoded(true),
+    serialized(),
+    type_encoding(tTypeEncoding::LOCAL_UIDS),
+    custom_encoder(NULL),
+    integer_encoding(tIntegerEncoding::FIXED),
+    packed_bool_vectors(false),
+    string_encoding(tStringEncoding::NULL_TERMINATED)
+  {}
+
+  tLazy(const T& value) : tLazy()
+  {
+    this->value = value;
+  }
+
+  /*!
+   * \return Wrapped value (decoded on first access)
+   */
+  const T& Get() const
+  {
+    if (!decoded)
+    {
+      Decode();
+    }
+    return value;
+  }
+
+  /*!
+   * \return Wrapped value (decoded on first access). As it may be modified, serialized bytes are discarded.
+   */
+  T& Get()
+  {
+    if (!decoded)
+    {
+      Decode();
+    }
+    serialized.clear();
+    return value;
+  }
+
+  /*!
+   * \return Number of serialized bytes that are retained for decoding or re-serialization (zero if there are none)
+   */
+  size_t GetSerializedSize() const
+  {
+    return serialized.size();
+  }
+
+  /*!
+   * \return Has value been decoded already? (also true for values that were not deserialized)
+   */
+  bool IsDecoded() const
+  {
+    return decoded;
+  }
+
+  /*!
+   * \param value New value
+   */
+  void Set(const T& value)
+  {
+    this->value = value;
+    decoded = true;
+    serialized.clear();
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  template <typename U>
+  friend tInputStream& operator >> (tInputStream& stream, tLazy<U>& lazy);
+  template <typename U>
+  friend tOutputStream& operator << (tOutputStream& stream, const tLazy<U>& lazy);
+
+  /*! Wrapped value */
+  mutable T value;
+
+  /*! Has value been decoded from 'serialized' already? */
+  mutable bool decoded;
+
+  /*! Serialized value - if it was deserialized and has not been modified */
+  std::vector<char> serialized;
+
+  /*! Type encoding of stream that value was read from */
+  tTypeEncoding type_encoding;
+
+  /*! Custom type encoder of stream that value was read from */
+  tTypeEncoder* custom_encoder;
+
+  /*! Integer encoding of stream that value was read from */
+  tIntegerEncoding integer_encoding;
+
+  /*! Packed bool vectors setting of stream that value was read from */
+  bool packed_bool_vectors;
+
+  /*! String encoding of stream that value was read from */
+  tStringEncoding string_encoding;
+
+
+  /*!
+   * Decodes value from serialized bytes
+   */
+  void Decode() const
+  {
+    tMemoryBuffer buffer(const_cast<char*>(serialized.data()), serialized.size());
+    if (custom_encoder)
+    {
+      tInputStream stream(*custom_encoder, integer_encoding);
+      Decode(stream, buffer);
+    }
+    else
+    {
+      tInputStream stream(type_encoding, integer_encoding);
+      Decode(stream, buffer);
+    }
+  }
+
+  /*!
+   * Decodes value from serialized bytes
+   *
+   * \param stream Input stream with encoding settings of stream that value was read from
+   * \param buffer Buffer wrapping serialized bytes
+   */
+  void Decode(tInputStream& stream, tMemoryBuffer& buffer) const
+  {
+    stream.SetPackedBoolVectors(packed_bool_vectors);
+    stream.SetStringEncoding(string_encoding);
+    stream.Reset(buffer);
+    stream >> value;
+    decoded = true;
+  }
+
+  /*!
+   * \param stream Output stream
+   * \return Can serialized bytes be written to this stream as they are?
+   */
+  bool SerializedCompatible(const tOutputStream& stream) const
+  {
+    return serialized.size() && stream.GetTypeEncoding() == type_encoding && stream.GetCustomTypeEncoder() == custom_encoder &&
+           stream.GetIntegerEncoding() == integer_encoding && stream.GetPackedBoolVectors() == packed_bool_vectors &&
+           stream.GetStringEncoding() == string_encoding;
+  }
+};
+
+namespace internal
+{
+
+/*!
+ * \return Pool for temporary buffers that tLazy values are serialized to
+ */
+inline tMemoryBufferPool& GetLazyBufferPool()
+{
+  static tMemoryBufferPool pool;
+  return pool;
+}
+
+}
+
+template <typename T>
+tOutputStream& operator << (tOutputStream& stream, const tLazy<T>& lazy)
+{
+  if (lazy.SerializedCompatible(stream))
+  {
+    stream.WriteInt(lazy.serialized.size());
+    stream.Write(lazy.serialized.data(), lazy.serialized.size());
+  }
+  else
+  {
+    tMemoryBufferPool::tPointer temp_buffer = internal::GetLazyBufferPool().Acquire();
+    {
+      tOutputStream temp_stream(*temp_buffer);
+      temp_stream.CopyEncodingSettings(stream);
+      temp_stream << lazy.Get();
+    }
+    stream.WriteInt(temp_buffer->GetSize());
+    stream.Write(temp_buffer->GetBufferPointer(), temp_buffer->GetSize());
+  }
+  return stream;
+}
+
+template <typename T>
+tInputStream& operator >> (tInputStream& stream, tLazy<T>& lazy)
+{
+  size_t size = static_cast<uint32_t>(stream.ReadInt());  // skip offset
+  lazy.serialized.resize(size);
+  if (size)
+  {
+    stream.ReadFully(lazy.serialized.data(), size);
+  }
+  lazy.decoded = false;
+  lazy.type_encoding = stream.GetTypeEncoding();
+  lazy.custom_encoder = stream.GetCustomTypeEncoder();
+  lazy.integer_encoding = stream.GetIntegerEncoding();
+  lazy.packed_bool_vectors = stream.GetPackedBoolVectors();
+  lazy.string_encoding = stream.GetStringEncoding();
+  return stream;
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+
+#endif
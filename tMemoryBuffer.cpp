@@ -173,36 +173,21 @@ void tMemoryBuffer::Reset(tInputStream& input_stream_buffer, tBufferInfo& buffer
   buffer.SetRange(0u, cur_size);
 }
 
-void tMemoryBuffer::Reset(tOutputStream& output_stream_buffer, tBufferInfo& buffer)
-{
-  EnsureCapacity(16, false, 0); // buffer should have at least space for 8+ bytes (in order to avoid assertion)
-  buffer.buffer = &backend;
-  buffer.position = 0u;
-  buffer.SetRange(0u, backend.Capacity());
-}
-
 void tMemoryBuffer::Seek(tInputStream& input_stream, tBufferInfo& buffer, uint64_t position) const
 {
-  // Since the input stream has the complete buffer, seeking can only occur out of range
-  throw std::out_of_range("Position out of range: " + std::to_string(position));
-}
-
-bool tMemoryBuffer::Write(tOutputStream& output_stream_buffer, tBufferInfo& buffer, int hint)
-{
-  // do we need size increase?
-  if (hint >= 0)
+  // The input stream has the complete buffer: it calls this when seeking out of range - or e.g. at the end of the buffer
+  if (position > cur_size)
   {
-    size_t new_size = std::max(8, static_cast<int>(((backend.Capacity() + hint) * resize_reserve_factor)));
-    EnsureCapacity(new_size, true, buffer.position);
-    buffer.buffer = &backend;
+    throw std::out_of_range("Position out of range: " + std::to_string(position));
   }
-  buffer.end = backend.Capacity();  // don't modify buffer start
-  return false;
+  buffer.buffer = const_cast<tFixedBuffer*>(&backend);
+  buffer.SetRange(0u, cur_size);
+  buffer.position = position;
 }
 
 tOutputStream& operator << (tOutputStream& stream, const tMemoryBuffer& buffer)
 {
-  stream.WriteLong(buffer.GetSize());
+  stream.WriteEncodedNumber<uint64_t>(buffer.GetSize());
   if (buffer.GetSize())
   {
     stream.Write(buffer.GetBuffer(), 0u, buffer.GetSize());
@@ -212,7 +197,7 @@ tOutputStream& operator << (tOutputStream& stream, const tMemoryBuffer& buffer)
 
 tInputStream& operator >> (tInputStream& stream, tMemoryBuffer& buffer)
 {
-  size_t size = stream.ReadLong();
+  size_t size = stream.ReadEncodedNumber<uint64_t>();
   buffer.cur_size = 0u;
   buffer.Reallocate(size, false, -1u);
   if (size)
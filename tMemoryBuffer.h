@@ -44,6 +44,7 @@
 //----------------------------------------------------------------------
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
+#include <algorithm>
 
 //----------------------------------------------------------------------
 // Internal includes with ""
@@ -66,6 +67,8 @@ namespace serialization
 //----------------------------------------------------------------------
 class tInputStream;
 class tOutputStream;
+template <typename TSink>
+class tStaticOutputStream;
 
 //----------------------------------------------------------------------
 // Class declaration
@@ -209,6 +212,18 @@ public:
     return cur_size;
   }
 
+  /*!
+   * Ensures that buffer has at least the specified capacity (keeps contents).
+   * Reserving the serialized size of an object (see GetSerializedSize()) before writing it
+   * avoids repeated reallocation and copying of large buffers.
+   *
+   * \param capacity Capacity in bytes
+   */
+  inline void Reserve(size_t capacity)
+  {
+    EnsureCapacity(capacity, true, cur_size);
+  }
+
   /*!
    * \param resize_reserve_factor the resizeReserveFactor to set
    */
@@ -228,6 +243,8 @@ public:
 private:
 
   friend tInputStream& operator >> (tInputStream& stream, tMemoryBuffer& buffer);
+  template <typename TSink>
+  friend class tStaticOutputStream;
 
 
   /*! Wrapped memory buffer */
@@ -307,7 +324,16 @@ private:
 
   virtual void Reset(tInputStream& input_stream_buffer, tBufferInfo& buffer) const override;
 
-  virtual void Reset(tOutputStream& output_stream_buffer, tBufferInfo& buffer) override;
+  virtual void Reset(tOutputStream& output_stream_buffer, tBufferInfo& buffer) override
+  {
+    if (backend.Capacity() < 16)
+    {
+      EnsureCapacity(16, false, 0); // buffer should have at least space for 8+ bytes (in order to avoid assertion)
+    }
+    buffer.buffer = &backend;
+    buffer.position = 0u;
+    buffer.SetRange(0u, backend.Capacity());
+  }
 
   virtual void Seek(tInputStream& input_stream, tBufferInfo& buffer, uint64_t position) const override;
 
@@ -316,7 +342,18 @@ private:
     return true;
   }
 
-  virtual bool Write(tOutputStream& output_stream_buffer, tBufferInfo& buffer, int hint) override;
+  virtual bool Write(tOutputStream& output_stream_buffer, tBufferInfo& buffer, int hint) override
+  {
+    // do we need size increase?
+    if (hint >= 0)
+    {
+      size_t new_size = std::max(8, static_cast<int>(((backend.Capacity() + hint) * resize_reserve_factor)));
+      EnsureCapacity(new_size, true, buffer.end);  // data after position is kept as well (see tSink::Write())
+      buffer.buffer = &backend;
+    }
+    buffer.end = backend.Capacity();  // don't modify buffer start
+    return false;
+  }
 };
 
 tOutputStream& operator << (tOutputStream& stream, const tMemoryBuffer& buffer);
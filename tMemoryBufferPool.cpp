@@ -0,0 +1,173 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/serialization/tMemoryBufferPool.cpp
+ *
+ * \author  agent
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#include "rrlib/serialization/tMemoryBufferPool.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <algorithm>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace serialization
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+const size_t tMemoryBufferPool::cMIN_CAPACITY;
+const size_t tMemoryBufferPool::cCAPACITY_CLASSES;
+const size_t tMemoryBufferPool::cDEFAULT_BUFFERS_PER_CLASS;
+
+tMemoryBufferPool::tMemoryBufferPool(size_t buffers_per_class) :
+  buffers_per_class(buffers_per_class),
+  slots(new std::atomic<tMemoryBuffer*>[cCAPACITY_CLASSES * buffers_per_class])
+{
+  for (size_t i = 0; i < cCAPACITY_CLASSES * buffers_per_class; i++)
+  {
+    slots[i].store(nullptr, std::memory_order_relaxed);
+  }
+}
+
+tMemoryBufferPool::~tMemoryBufferPool()
+{
+  for (size_t i = 0; i < cCAPACITY_CLASSES * buffers_per_class; i++)
+  {
+    delete slots[i].load(std::memory_order_acquire);
+  }
+}
+
+tMemoryBufferPool::tPointer tMemoryBufferPool::Acquire(size_t min_capacity)
+{
+  tReturnToPool deleter = { this };
+  int capacity_class = std::max(0, GetCapacityClass(min_capacity));
+  if (static_cast<size_t>(capacity_class) < cCAPACITY_CLASSES && (cMIN_CAPACITY << capacity_class) < min_capacity)
+  {
+    capacity_class++;  // class with sufficient capacity
+  }
+  if (static_cast<size_t>(capacity_class) >= cCAPACITY_CLASSES)
+  {
+    return tPointer(new tMemoryBuffer(min_capacity), deleter);  // too large for pool
+  }
+
+  // free buffer of this class - or of the next larger class
+  for (size_t c = capacity_class; c < std::min<size_t>(capacity_class + 2, cCAPACITY_CLASSES); c++)
+  {
+    tMemoryBuffer* buffer = TakeFreeBuffer(c);
+    if (buffer)
+    {
+      return tPointer(buffer, deleter);
+    }
+  }
+  return tPointer(new tMemoryBuffer(cMIN_CAPACITY << capacity_class), deleter);
+}
+
+int tMemoryBufferPool::GetCapacityClass(size_t buffer_capacity)
+{
+  if (buffer_capacity < cMIN_CAPACITY)
+  {
+    return -1;
+  }
+  size_t capacity_class = 0;
+  while (capacity_class < cCAPACITY_CLASSES && (cMIN_CAPACITY << (capacity_class + 1)) <= buffer_capacity)
+  {
+    capacity_class++;
+  }
+  return static_cast<int>(capacity_class);
+}
+
+void tMemoryBufferPool::Return(tMemoryBuffer* buffer)
+{
+  buffer->Clear();
+  buffer->SetResizeReserveFactor(tMemoryBuffer::cDEFAULT_RESIZE_FACTOR);
+  int capacity_class = GetCapacityClass(buffer->GetCapacity());
+  if (capacity_class >= 0 && static_cast<size_t>(capacity_class) < cCAPACITY_CLASSES)
+  {
+    std::atomic<tMemoryBuffer*>* class_slots = &slots[capacity_class * buffers_per_class];
+    for (size_t i = 0; i < buffers_per_class; i++)
+    {
+      tMemoryBuffer* expected = nullptr;
+      if (class_slots[i].load(std::memory_order_relaxed) == nullptr &&
+          class_slots[i].compare_exchange_strong(expected, buffer, std::memory_order_release, std::memory_order_relaxed))
+      {
+        return;
+      }
+    }
+  }
+  delete buffer;  // no free slot
+}
+
+tMemoryBuffer* tMemoryBufferPool::TakeFreeBuffer(size_t capacity_class)
+{
+  std::atomic<tMemoryBuffer*>* class_slots = &slots[capacity_class * buffers_per_class];
+  for (size_t i = 0; i < buffers_per_class; i++)
+  {
+    if (class_slots[i].load(std::memory_order_relaxed) != nullptr)
+    {
+      tMemoryBuffer* buffer = class_slots[i].exchange(nullptr, std::memory_order_acquire);
+      if (buffer)
+      {
+        return buffer;
+      }
+    }
+  }
+  return nullptr;
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
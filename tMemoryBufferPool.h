@@ -0,0 +1,166 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/serialization/tMemoryBufferPool.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tMemoryBufferPool
+ *
+ * \b tMemoryBufferPool
+ *
+ * Thread-safe pool of reusable memory buffers.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__serialization__tMemoryBufferPool_h__
+#define __rrlib__serialization__tMemoryBufferPool_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "rrlib/util/tNoncopyable.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/serialization/tMemoryBuffer.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace serialization
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Pool of reusable memory buffers
+/*!
+ * Thread-safe pool of memory buffers - e.g. for serializing messages that are published
+ * by multiple threads - so that no memory needs to be allocated in steady state.
+ *
+ * Buffers are sorted by capacity class (capacity cMIN_CAPACITY * 2^i).
+ * Acquired buffers are returned to the pool automatically (cleared) when the returned pointer is reset or destructed.
+ * Buffers that grew while they were used are returned to the class of their new capacity.
+ * If there is no free slot for a returned buffer, it is deleted.
+ *
+ * Acquiring and returning buffers is lock-free: each capacity class has a fixed number of
+ * slots that contain either a free buffer or null.
+ * The pool must exist as long as any of its buffers is in use.
+ */
+class tMemoryBufferPool : private util::tNoncopyable
+{
+
+  /*! Returns buffer to pool (deleter for tPointer) */
+  struct tReturnToPool
+  {
+    tMemoryBufferPool* pool;
+
+    void operator()(tMemoryBuffer* buffer) const
+    {
+      pool->Return(buffer);
+    }
+  };
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*! Pointer to buffer from pool - returns buffer to pool when reset or destructed */
+  typedef std::unique_ptr<tMemoryBuffer, tReturnToPool> tPointer;
+
+  /*! Capacity of buffers in smallest capacity class */
+  static const size_t cMIN_CAPACITY = tMemoryBuffer::cDEFAULT_SIZE;
+
+  /*! Number of capacity classes (buffers larger than the largest class are not pooled) */
+  static const size_t cCAPACITY_CLASSES = 16;
+
+  /*! Default number of buffers that can be stored per capacity class */
+  static const size_t cDEFAULT_BUFFERS_PER_CLASS = 32;
+
+  /*!
+   * \param buffers_per_class Maximum number of free buffers that are stored per capacity class
+   */
+  tMemoryBufferPool(size_t buffers_per_class = cDEFAULT_BUFFERS_PER_CLASS);
+
+  /*! Deletes all free buffers */
+  ~tMemoryBufferPool();
+
+  /*!
+   * Obtains an empty buffer from pool (allocates a new buffer, if no suitable buffer is available)
+   *
+   * \param min_capacity Minimum capacity of buffer
+   * \return Buffer
+   */
+  tPointer Acquire(size_t min_capacity = cMIN_CAPACITY);
+
+  /*!
+   * \param buffer_capacity Capacity of a buffer
+   * \return Index of largest capacity class whose capacity does not exceed buffer_capacity (cCAPACITY_CLASSES if buffer is too large for pool; -1 if it is too small)
+   */
+  static int GetCapacityClass(size_t buffer_capacity);
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Maximum number of free buffers that are stored per capacity class */
+  const size_t buffers_per_class;
+
+  /*! Slots for free buffers: 'buffers_per_class' slots per capacity class (empty slots contain null) */
+  std::unique_ptr<std::atomic<tMemoryBuffer*>[]> slots;
+
+  /*!
+   * Returns buffer to pool (called by tReturnToPool)
+   *
+   * \param buffer Buffer to return
+   */
+  void Return(tMemoryBuffer* buffer);
+
+  /*!
+   * \param capacity_class Index of capacity class
+   * \return Free buffer of this capacity class - or null, if there is none
+   */
+  tMemoryBuffer* TakeFreeBuffer(size_t capacity_class);
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+
+#endif
@@ -32,6 +32,7 @@
 //----------------------------------------------------------------------
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
+#include <cstring>
 
 //----------------------------------------------------------------------
 // Internal includes with ""
@@ -67,42 +68,82 @@ namespace serialization
 // Implementation
 //----------------------------------------------------------------------
 
-const double tOutputStream::cBUFFER_COPY_FRACTION = 0.25;
-
-tOutputStream::tOutputStream(tTypeEncoding encoding) :
+tOutputStream::tOutputStream(tTypeEncoding encoding, tIntegerEncoding integer_encoding) :
   sink(NULL),
   immediate_flush(false),
   closed(true),
   buffer(),
-  cur_skip_offset_placeholder(-1),
-  short_skip_offset(false),
-  buffer_copy_fraction(0),
+  buffer_offset(0),
+  skip_offset_placeholders(),
+  sink_direct_write_threshold(0),
+  fixed_direct_write_threshold(0),
+  average_block_size(0),
   direct_write_support(false),
   encoding(encoding),
-  custom_encoder(NULL)
+  custom_encoder(NULL),
+  integer_encoding(integer_encoding),
+  packed_bool_vectors(false),
+  string_encoding(tStringEncoding::NULL_TERMINATED),
+  sink_operations(&GetSinkOperations<tVirtualSinkCalls>())
 {
 }
 
 void tOutputStream::Close()
 {
-  if (!closed)
-  {
-    Flush();
-    sink->Close(*this, buffer);
-  }
-  closed = true;
+  sink_operations->close(*this);
+}
+
+void tOutputStream::Commit(const tMark& mark)
+{
+  assert(mark.index < marks.size());
+  marks.resize(mark.index);
 }
 
-void tOutputStream::CommitData(int add_size_hint)
+void tOutputStream::MoveMarkedData(tFixedBuffer* old_buffer, size_t marked_size, bool invalidated, int add_size_hint)
 {
-  if (GetPosition() > 0)
+  size_t marked_start = marks.front();
+  int64_t shift = static_cast<int64_t>(buffer.position) - static_cast<int64_t>(marked_start);
+  buffer_offset -= shift;
+  for (size_t & mark : marks)
+  {
+    mark += shift;
+  }
+  if (buffer.Remaining() < marked_size + (add_size_hint < 0 ? 0 : 8))
   {
-    if (sink->Write(*this, buffer, add_size_hint))
+    // marked data is discarded: marks remain open at position of oldest mark (see Mark())
+    for (size_t & mark : marks)
+    {
+      mark = buffer.position;
+    }
+    while ((!skip_offset_placeholders.empty()) && skip_offset_placeholders.back().position >= GetAbsolutePosition())
     {
-      assert((cur_skip_offset_placeholder < 0));
+      skip_offset_placeholders.pop_back();
+    }
+    throw std::length_error("Data written after open marks exceeds buffer capacity of sink");
+  }
+
+  // marked data is still in the same buffer - or in the previous one (see tSink::Write())
+  if (buffer.buffer != old_buffer)
+  {
+    buffer.buffer->Put(buffer.position, *old_buffer, marked_start, marked_size);
+  }
+  else if (shift != 0 && marked_size)
+  {
+    memmove(buffer.buffer->GetPointer() + buffer.position, buffer.buffer->GetPointer() + marked_start, marked_size);
+  }
+  buffer.position += marked_size;
+  for (tSkipOffsetPlaceholder & placeholder : skip_offset_placeholders)
+  {
+    if (placeholder.buffer == old_buffer && placeholder.buffer_position >= marked_start)
+    {
+      // placeholder was moved to new buffer with marked data
+      placeholder.buffer = buffer.buffer;
+      placeholder.buffer_position += shift;
+    }
+    else
+    {
+      assert(!invalidated);
     }
-    assert(add_size_hint < 0 || buffer.Remaining() >= 8);
-    buffer_copy_fraction = static_cast<size_t>((buffer.Capacity() * cBUFFER_COPY_FRACTION));
   }
 }
 
@@ -117,16 +158,24 @@ void tOutputStream::Reset(tSink& sink)
 {
   Close();
   this->sink = &sink;
+  sink_operations = &GetSinkOperations<tVirtualSinkCalls>();
   Reset();
 }
 
 void tOutputStream::Reset()
 {
-  sink->Reset(*this, buffer);
-  assert((buffer.Remaining() >= 8));
-  closed = false;
-  buffer_copy_fraction = static_cast<size_t>((buffer.Capacity() * cBUFFER_COPY_FRACTION));
-  direct_write_support = sink->DirectWriteSupport();
+  sink_operations->reset(*this);
+}
+
+void tOutputStream::Rollback(const tMark& mark)
+{
+  assert(mark.index < marks.size());
+  buffer.position = marks[mark.index];
+  marks.resize(mark.index);
+  while ((!skip_offset_placeholders.empty()) && skip_offset_placeholders.back().position >= GetAbsolutePosition())
+  {
+    skip_offset_placeholders.pop_back();
+  }
 }
 
 void tOutputStream::Seek(size_t position)
@@ -141,50 +190,50 @@ void tOutputStream::Seek(size_t position)
 
 void tOutputStream::SkipTargetHere()
 {
-  assert(cur_skip_offset_placeholder >= 0);
-  if (short_skip_offset)
+  assert(!skip_offset_placeholders.empty());
+  const tSkipOffsetPlaceholder& placeholder = skip_offset_placeholders.back();
+  size_t skip_offset = GetSkipOffset();
+  if (placeholder.short_skip_offset)
   {
-    buffer.buffer->PutByte(cur_skip_offset_placeholder, buffer.position - cur_skip_offset_placeholder - 1);
+    assert(skip_offset < 256 && "Skip offset too large for short placeholder");
+    placeholder.buffer->PutByte(placeholder.buffer_position, skip_offset);
   }
   else
   {
-    buffer.buffer->PutInt(cur_skip_offset_placeholder, buffer.position - cur_skip_offset_placeholder - 4);
+    placeholder.buffer->PutInt(placeholder.buffer_position, skip_offset);
   }
-  cur_skip_offset_placeholder = -1;
+  skip_offset_placeholders.pop_back();
 }
 
 void tOutputStream::Write(const tFixedBuffer& bb, size_t off, size_t len)
 {
-  if ((Remaining() >= len) && (len < GetCopyFraction() || cur_skip_offset_placeholder >= 0))
+  if (direct_write_support && skip_offset_placeholders.empty() && marks.empty())
   {
-    buffer.buffer->Put(buffer.position, bb, off, len);
-    buffer.position += len;
-  }
-  else
-  {
-    if (direct_write_support && cur_skip_offset_placeholder < 0)
+    if (len >= GetDirectWriteThreshold() / 4)
     {
-      CommitData(-1);
-      sink->DirectWrite(*this, bb, off, len);
+      // small writes (e.g. of strings) are not sampled - they would drag the threshold towards zero
+      average_block_size = (average_block_size * 7 + len) / 8;
     }
-    else
+    if (Remaining() < len || len >= GetDirectWriteThreshold())
     {
-      while (len > 0)
-      {
-        int write = std::min(len, Remaining());
-        buffer.buffer->Put(buffer.position, bb, off, write);
-        buffer.position += write;
-        len -= write;
-        off += write;
-        assert((len >= 0));
-        if (len == 0)
-        {
-          return;
-        }
-        CommitData(len);
-      }
+      sink_operations->write_direct(*this, bb, off, len);
+      return;
     }
   }
+
+  while (true)
+  {
+    size_t write = std::min(len, Remaining());
+    buffer.buffer->Put(buffer.position, bb, off, write);
+    buffer.position += write;
+    len -= write;
+    off += write;
+    if (len == 0)
+    {
+      return;
+    }
+    CommitData(len);
+  }
 }
 
 void tOutputStream::WriteAllAvailable(tInputStream& input_stream)
@@ -199,9 +248,9 @@ void tOutputStream::WriteAllAvailable(tInputStream& input_stream)
 
 void tOutputStream::WriteSkipOffsetPlaceholder(bool short_skip_offset)
 {
-  assert((cur_skip_offset_placeholder < 0));
-  cur_skip_offset_placeholder = buffer.position;
-  this->short_skip_offset = short_skip_offset;
+  EnsureAdditionalCapacity(short_skip_offset ? 1 : 4);  // placeholder is written to current buffer in one piece
+  tSkipOffsetPlaceholder placeholder = { GetAbsolutePosition(), buffer.buffer, buffer.position, short_skip_offset };
+  skip_offset_placeholders.push_back(placeholder);
 
   if (short_skip_offset)
   {
@@ -215,6 +264,12 @@ void tOutputStream::WriteSkipOffsetPlaceholder(bool short_skip_offset)
 
 void tOutputStream::WriteString(const std::string& s, bool terminate)
 {
+  if (terminate && string_encoding == tStringEncoding::LENGTH_PREFIXED)
+  {
+    WriteEncodedNumber<uint32_t>(s.size());
+    Write(tFixedBuffer((char*)s.data(), s.size()));
+    return;
+  }
   size_t len = terminate ? (s.size() + 1) : s.size();
   Write(tFixedBuffer((char*)s.c_str(), len));
 }
@@ -60,6 +60,8 @@
 //----------------------------------------------------------------------
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
+#include <algorithm>
+#include <vector>
 #include "rrlib/util/tNoncopyable.h"
 #include "rrlib/time/time.h"
 #include "rrlib/util/tEnumBasedFlags.h"
@@ -71,6 +73,8 @@
 #include "rrlib/serialization/tBufferInfo.h"
 #include "rrlib/serialization/tSink.h"
 #include "rrlib/serialization/tTypeEncoder.h"
+#include "rrlib/serialization/detail/byte_order.h"
+#include "rrlib/serialization/detail/tEnumValueIndex.h"
 
 //----------------------------------------------------------------------
 // Namespace declaration
@@ -91,6 +95,8 @@ template <typename T>
 class IsSerializableContainer;
 template <typename T>
 class IsSerializableMap;
+template <typename TSink>
+class tStaticOutputStream;
 
 //----------------------------------------------------------------------
 // Class declaration
@@ -127,11 +133,196 @@ class tOutputStream : private util::tNoncopyable
 //----------------------------------------------------------------------
 public:
 
+  /*!
+   * Handle for a stream position marked with Mark()
+   */
+  class tMark
+  {
+    friend class tOutputStream;
+    template <typename TSink>
+    friend class tStaticOutputStream;
+
+    /*! Index of mark in stack of open marks */
+    size_t index;
+
+    explicit tMark(size_t index) : index(index)
+    {}
+  };
+
+  /*!
+   * Writes primitives to a memory region that was reserved in an output stream's
+   * current buffer (see tOutputStream::Reserve()) - without any capacity checks.
+   * Endianness is handled just like in tOutputStream.
+   *
+   * The stream's position is updated when this writer is destructed.
+   * The output stream may not be used while this writer exists.
+   */
+  class tReservedWriter
+  {
+  public:
+
+    tReservedWriter(tReservedWriter && other) :
+      stream(other.stream),
+      position(other.position),
+      end(other.end)
+    {
+      other.stream = NULL;
+    }
+
+    ~tReservedWriter()
+    {
+      Commit();
+    }
+
+    /*!
+     * Updates position of output stream (called automatically by destructor).
+     * Writer must not be used after calling this.
+     */
+    void Commit()
+    {
+      if (stream)
+      {
+        stream->buffer.position = position - stream->buffer.buffer->GetPointer();
+        stream = NULL;
+      }
+    }
+
+    /*!
+     * \return Number of reserved bytes that have not been written yet
+     */
+    size_t Remaining() const
+    {
+      return end - position;
+    }
+
+    /*!
+     * \param address Address of data to write
+     * \param size Length (in bytes) of data to write
+     */
+    inline void Write(const void* address, size_t size)
+    {
+      assert(position + size <= end);
+      memcpy(position, address, size);
+      position += size;
+    }
+
+    /*!
+     * \param v (1-byte) boolean
+     */
+    inline void WriteBoolean(bool v)
+    {
+      WriteNumber<int8_t>(v ? 1 : 0);
+    }
+
+    /*!
+     * \param v 8 bit integer
+     */
+    inline void WriteByte(int v)
+    {
+      WriteNumber<int8_t>(static_cast<int8_t>(v));
+    }
+
+    /*!
+     * \param v 64 bit floating point
+     */
+    inline void WriteDouble(double v)
+    {
+      assert(position + 8u <= end);
+      memcpy(position, &v, 8u);
+      position += 8u;
+    }
+
+    /*!
+     * \param v 32 bit floating point
+     */
+    inline void WriteFloat(float v)
+    {
+      assert(position + 4u <= end);
+      memcpy(position, &v, 4u);
+      position += 4u;
+    }
+
+    /*!
+     * \param v 32 bit integer
+     */
+    inline void WriteInt(int v)
+    {
+      WriteNumber(v);
+    }
+
+    /*!
+     * \param v 64 bit integer
+     */
+    inline void WriteLong(int64_t v)
+    {
+      WriteNumber(v);
+    }
+
+    /*!
+     * Write integer - taking care of endianness
+     *
+     * \param t Integer to write
+     */
+    template <typename T>
+    inline void WriteNumber(T t)
+    {
+      assert(position + sizeof(T) <= end);
+
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+      T tmp = t;
+      char* dest = reinterpret_cast<char*>(&t);
+      char* src = reinterpret_cast<char*>(&tmp);
+      src += sizeof(T);
+      for (size_t i = 0; i < sizeof(T); i++)
+      {
+        src--;
+        *dest = *src;
+        dest++;
+      }
+#endif
+
+      memcpy(position, &t, sizeof(T));
+      position += sizeof(T);
+    }
+
+    /*!
+     * \param v 16 bit integer
+     */
+    inline void WriteShort(int v)
+    {
+      WriteNumber<int16_t>(static_cast<int16_t>(v));
+    }
+
+  private:
+
+    friend class tOutputStream;
+
+    /*! Output stream that this writer writes to (NULL after commit) */
+    tOutputStream* stream;
+
+    /*! Current write position */
+    char* position;
+
+    /*! End of reserved region */
+    char* end;
+
+    tReservedWriter(tOutputStream& stream, size_t size) :
+      stream(&stream),
+      position(stream.buffer.buffer->GetPointer() + stream.buffer.position),
+      end(position + size)
+    {}
+
+    tReservedWriter(const tReservedWriter&) = delete;
+    tReservedWriter& operator=(const tReservedWriter&) = delete;
+  };
+
   /*!
    * \param sink Sink to write to
    * \param encoding Data type encoding to use when data types from rrlib::rtti are serialized (optional)
+   * \param integer_encoding Encoding of container sizes, enum indices and numbers written with WriteEncodedNumber (optional)
    */
-  tOutputStream(tSink& sink, tTypeEncoding encoding = tTypeEncoding::LOCAL_UIDS) : tOutputStream(encoding)
+  tOutputStream(tSink& sink, tTypeEncoding encoding = tTypeEncoding::LOCAL_UIDS, tIntegerEncoding integer_encoding = tIntegerEncoding::FIXED) :
+    tOutputStream(encoding, integer_encoding)
   {
     Reset(sink);
   }
@@ -139,8 +330,9 @@ public:
   /*!
    * \param sink Sink to write to
    * \param encoder Custom type encoder to use when data types from rrlib::rtti are serialized
+   * \param integer_encoding Encoding of container sizes, enum indices and numbers written with WriteEncodedNumber (optional)
    */
-  tOutputStream(tSink& sink, tTypeEncoder& encoder) : tOutputStream(encoder)
+  tOutputStream(tSink& sink, tTypeEncoder& encoder, tIntegerEncoding integer_encoding = tIntegerEncoding::FIXED) : tOutputStream(encoder, integer_encoding)
   {
     Reset(sink);
   }
@@ -149,15 +341,17 @@ public:
    * Note: Reset() with a sink must be called, before data can be written
    *
    * \param encoding Data type encoding to use when data types from rrlib::rtti are serialized (optional)
+   * \param integer_encoding Encoding of container sizes, enum indices and numbers written with WriteEncodedNumber (optional)
    */
-  tOutputStream(tTypeEncoding encoding = tTypeEncoding::LOCAL_UIDS);
+  tOutputStream(tTypeEncoding encoding = tTypeEncoding::LOCAL_UIDS, tIntegerEncoding integer_encoding = tIntegerEncoding::FIXED);
 
   /*!
    * Note: Reset() with a sink must be called, before data can be written
    *
    * \param encoder Custom type encoder to use when data types from rrlib::rtti are serialized
+   * \param integer_encoding Encoding of container sizes, enum indices and numbers written with WriteEncodedNumber (optional)
    */
-  tOutputStream(tTypeEncoder& encoder) : tOutputStream(tTypeEncoding::CUSTOM)
+  tOutputStream(tTypeEncoder& encoder, tIntegerEncoding integer_encoding = tIntegerEncoding::FIXED) : tOutputStream(tTypeEncoding::CUSTOM, integer_encoding)
   {
     custom_encoder = &encoder;
   }
@@ -170,9 +364,18 @@ public:
   /*!
    * Close output stream.
    * Flushes all bytes written to sink.
+   * Data written after open marks (see Mark()) is discarded.
    */
   void Close();
 
+  /*!
+   * Commits data written after the specified mark: it may now be written to the sink.
+   * Removes the mark - and any marks that were set after it.
+   *
+   * \param mark Mark to commit
+   */
+  void Commit(const tMark& mark);
+
   /*!
    * Ensure that the specified number of bytes is available in buffer.
    * Possibly resize or flush.
@@ -187,14 +390,28 @@ public:
     }
   }
 
+  /*!
+   * Copies encoding settings from another output stream:
+   * type encoding (and custom type encoder), integer encoding, packed bool vectors and string encoding
+   *
+   * \param other Stream to copy settings from
+   */
+  void CopyEncodingSettings(const tOutputStream& other)
+  {
+    encoding = other.encoding;
+    custom_encoder = other.custom_encoder;
+    integer_encoding = other.integer_encoding;
+    packed_bool_vectors = other.packed_bool_vectors;
+    string_encoding = other.string_encoding;
+  }
+
   /*!
    * Flush current buffer contents to sink and clear buffer.
    * (with no immediate intent to write further data to buffer)
    */
   inline void Flush()
   {
-    CommitData(-1);
-    sink->Flush(*this, buffer);
+    sink_operations->flush(*this);
   }
 
   /*!
@@ -205,6 +422,24 @@ public:
     return custom_encoder;
   }
 
+  /*!
+   * Blocks written via Write(const tFixedBuffer&, ...) are copied to the current buffer, when they are smaller than this threshold.
+   * Larger blocks are forwarded to the sink directly (if it supports this).
+   * Unless a fixed threshold is set, the threshold preferred by the sink is raised to twice the average block size
+   * (up to half the buffer capacity), so that streams of similarly-sized medium blocks are copied rather than forwarded one by one.
+   * Only blocks of at least a quarter of the current threshold are included in this average.
+   *
+   * \return Current direct write threshold in bytes
+   */
+  inline size_t GetDirectWriteThreshold() const
+  {
+    if (fixed_direct_write_threshold)
+    {
+      return fixed_direct_write_threshold;
+    }
+    return std::max(sink_direct_write_threshold, std::min(buffer.Capacity() / 2, 2 * average_block_size));
+  }
+
   /*!
    * \return Position in current internal buffer provided by the Sink.
    * With a tMemoryBuffer sink, this is the actual position in the tMemoryBuffer
@@ -224,6 +459,71 @@ public:
     return encoding;
   }
 
+  /*!
+   * \return Encoding of container sizes, enum indices and numbers written with WriteEncodedNumber
+   */
+  tIntegerEncoding GetIntegerEncoding() const
+  {
+    return integer_encoding;
+  }
+
+  /*!
+   * \return Are std::vector<bool> written in bit-packed format (8 elements per byte)?
+   */
+  bool GetPackedBoolVectors() const
+  {
+    return packed_bool_vectors;
+  }
+
+  /*!
+   * \return Encoding of strings written with WriteString
+   */
+  tStringEncoding GetStringEncoding() const
+  {
+    return string_encoding;
+  }
+
+  /*!
+   * \return Skip offset that SkipTargetHere() would currently write: number of bytes written after the innermost
+   * skip offset placeholder whose target has not been set yet (e.g. to record offsets of elements in a block).
+   */
+  size_t GetSkipOffset() const
+  {
+    assert(!skip_offset_placeholders.empty());
+    const tSkipOffsetPlaceholder& placeholder = skip_offset_placeholders.back();
+    return static_cast<size_t>(GetAbsolutePosition() - placeholder.position) - (placeholder.short_skip_offset ? 1 : 4);
+  }
+
+  /*!
+   * Marks the current position in the stream - so that all data written after it can be discarded
+   * (e.g. if serializing an object fails halfway):
+   *
+   *   auto mark = stream.Mark();
+   *   try
+   *   {
+   *     stream << object;
+   *     stream.Commit(mark);
+   *   }
+   *   catch (const std::exception& e)
+   *   {
+   *     stream.Rollback(mark);
+   *   }
+   *
+   * Data written after an open mark does not reach the sink before the mark is committed.
+   * With sinks that provide a new buffer when data is written (e.g. tFileSink),
+   * data written after open marks must therefore fit into the sink's buffer.
+   * Otherwise, std::length_error is thrown: all data written after the oldest open mark is then discarded
+   * (the marks remain open at the position of the oldest mark - so that they can still be rolled back or committed).
+   * Marks may be nested. Committing or rolling back a mark also removes all marks set after it.
+   *
+   * \return Handle for marked position
+   */
+  inline tMark Mark()
+  {
+    marks.push_back(buffer.position);
+    return tMark(marks.size() - 1);
+  }
+
   /*!
    * Print String to StreamBuffer.
    *
@@ -242,6 +542,34 @@ public:
    */
   void Println(const std::string& s);
 
+  /*!
+   * Reserves the specified number of bytes in the current buffer with a single capacity check.
+   * The returned writer can then write primitives to this region without any further checks.
+   * This is useful e.g. for writing fixed-layout structs efficiently:
+   *
+   *   {
+   *     auto writer = stream.Reserve(12);
+   *     writer.WriteInt(x);
+   *     writer.WriteDouble(y);
+   *   } // stream position is updated here
+   *
+   * Bytes that are not written are not added to the stream.
+   * The stream must not be used while the writer exists.
+   *
+   * \param size Number of bytes to reserve
+   * \return Writer for the reserved region
+   * \exception std::invalid_argument is thrown if the sink's buffer cannot provide the requested number of bytes
+   */
+  inline tReservedWriter Reserve(size_t size)
+  {
+    EnsureAdditionalCapacity(size);
+    if (Remaining() < size)
+    {
+      throw std::invalid_argument("Sink cannot provide a buffer of the requested size");
+    }
+    return tReservedWriter(*this, size);
+  }
+
   /*!
    * Resets/clears buffer for writing
    */
@@ -254,6 +582,14 @@ public:
    */
   void Reset(tSink& sink);
 
+  /*!
+   * Discards all data written after the specified mark (the stream continues at the marked position).
+   * Removes the mark - and any marks that were set after it.
+   *
+   * \param mark Mark to roll back to
+   */
+  void Rollback(const tMark& mark);
+
   /*!
    * Seeks the specified position in the current internal buffer provided by the Sink.
    * With a tMemoryBuffer sink, this is the actual position in the tMemoryBuffer.
@@ -273,8 +609,44 @@ public:
    */
   void Seek(size_t position);
 
+  /*!
+   * \param threshold Fixed direct write threshold in bytes (see GetDirectWriteThreshold()). Zero restores the adaptive threshold.
+   */
+  void SetDirectWriteThreshold(size_t threshold)
+  {
+    fixed_direct_write_threshold = threshold;
+  }
+
+  /*!
+   * \param integer_encoding Encoding of container sizes, enum indices and numbers written with WriteEncodedNumber
+   * (Input streams need to be configured accordingly)
+   */
+  void SetIntegerEncoding(tIntegerEncoding integer_encoding)
+  {
+    this->integer_encoding = integer_encoding;
+  }
+
+  /*!
+   * \param packed_bool_vectors Write std::vector<bool> in bit-packed format (8 elements per byte)?
+   * (Disabled by default. Input streams need to be configured accordingly - see tInputStream::SetPackedBoolVectors)
+   */
+  void SetPackedBoolVectors(bool packed_bool_vectors)
+  {
+    this->packed_bool_vectors = packed_bool_vectors;
+  }
+
+  /*!
+   * \param string_encoding Encoding of strings written with WriteString
+   * (Null-terminated by default. Input streams need to be configured accordingly - see tInputStream::SetStringEncoding)
+   */
+  void SetStringEncoding(tStringEncoding string_encoding)
+  {
+    this->string_encoding = string_encoding;
+  }
+
   /*!
    * Set target for last "skip offset" to this position.
+   * (with nested skip offsets, this is the innermost placeholder whose target has not been set yet)
    */
   void SkipTargetHere();
 
@@ -352,6 +724,32 @@ public:
     buffer.position += 8u;
   }
 
+  /*!
+   * Write integer to stream - using the integer encoding of this stream
+   * (fixed size or variable length; see tIntegerEncoding).
+   * Must be read with tInputStream::ReadEncodedNumber<T>().
+   *
+   * \param t Integer to write to stream
+   */
+  template <typename T>
+  void WriteEncodedNumber(T t)
+  {
+    static_assert(std::is_integral<T>::value, "Only integral types are supported");
+    if (integer_encoding == tIntegerEncoding::FIXED)
+    {
+      WriteNumber(t);
+    }
+    else if (std::is_signed<T>::value)
+    {
+      int64_t value = static_cast<int64_t>(t);
+      WriteVarint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));  // zigzag encoding
+    }
+    else
+    {
+      WriteVarint(static_cast<uint64_t>(t));
+    }
+  }
+
   /*!
    * \param e Enum constant to serialize
    */
@@ -374,28 +772,19 @@ public:
     const make_builder::internal::tEnumStrings& enum_strings = make_builder::internal::GetEnumStrings<ENUM>();
     size_t enum_strings_dimension = enum_strings.size;
     size_t enum_index = static_cast<size_t>(e);
-    if (enum_strings.non_standard_values)
+    if (enum_strings.non_standard_values && (!detail::tEnumValueIndex<ENUM>::Find(e, enum_index)))
     {
-      bool found = false;
-      for (size_t i = 0; i < enum_strings_dimension; i++)
-      {
-        if (e == static_cast<const ENUM*>(enum_strings.non_standard_values)[i])
-        {
-          enum_index = i;
-          found = true;
-          break;
-        }
-      }
-      if (!found)
-      {
-        throw std::runtime_error("Invalid enum value");
-      }
+      throw std::runtime_error("Invalid enum value");
     }
 
     if (enum_strings_dimension <= 0x100)
     {
       WriteByte((int8_t)enum_index);
     }
+    else if (integer_encoding == tIntegerEncoding::VARIABLE)
+    {
+      WriteVarint(enum_index);
+    }
     else if (enum_strings_dimension <= 0x10000)
     {
       WriteShort((int16_t)enum_index);
@@ -460,6 +849,40 @@ public:
     buffer.position += sizeof(T);
   }
 
+  /*!
+   * Writes array of numbers to stream - taking care of endianness.
+   * This is much more efficient than calling WriteNumber() for every value:
+   * On little endian platforms, the whole array is written with a single Write() call.
+   * On big endian platforms, byte order is swapped while copying chunks of the array to the current buffer.
+   *
+   * \param values Pointer to first number
+   * \param count Number of numbers to write
+   */
+  template <typename T>
+  void WriteNumbers(const T* values, size_t count)
+  {
+    static_assert(IsBulkSerializable<T>::value, "Only supported for bulk serializable types");
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    if (std::is_integral<T>::value && sizeof(T) > 1)
+    {
+      while (count)
+      {
+        EnsureAdditionalCapacity(sizeof(T));
+        size_t chunk_count = std::min(count, Remaining() / sizeof(T));
+        detail::SwapByteOrder<T>(values, buffer.buffer->GetPointer() + buffer.position, chunk_count);
+        buffer.position += chunk_count * sizeof(T);
+        values += chunk_count;
+        count -= chunk_count;
+      }
+      return;
+    }
+#endif
+    if (count)
+    {
+      Write(values, count * sizeof(T));
+    }
+  }
+
   /*!
    * \param v 16 bit integer
    */
@@ -469,13 +892,40 @@ public:
   }
 
   /*!
-   * A "skip offset" will be written to this position in the stream.
+   * Write unsigned integer in variable-length LEB128 format
+   * (7 bits per byte, least significant group first; most significant bit set in all but the last byte).
+   * Values smaller than 128 need a single byte.
    *
-   * (only one such position can be set/remembered at a time)
+   * \param v Integer to write to stream
+   */
+  inline void WriteVarint(uint64_t v)
+  {
+    size_t size = 1;
+    for (uint64_t rest = v >> 7; rest; rest >>= 7)
+    {
+      size++;
+    }
+    EnsureAdditionalCapacity(size);
+    while (v >= 0x80)
+    {
+      buffer.buffer->PutGeneric<uint8_t>(buffer.position, static_cast<uint8_t>(v | 0x80));
+      buffer.position++;
+      v >>= 7;
+    }
+    buffer.buffer->PutGeneric<uint8_t>(buffer.position, static_cast<uint8_t>(v));
+    buffer.position++;
+  }
+
+  /*!
+   * A "skip offset" will be written to this position in the stream.
    *
    * As soon as the stream has reached the position to which a reader might want to skip
    * call SkipTargetHere()
    *
+   * Skip offsets may be nested (e.g. for sub-objects inside a skippable block):
+   * each placeholder must be matched by a call to SkipTargetHere() - the innermost placeholder first.
+   * As long as placeholders are pending, the data written since the outermost one is kept in the buffer.
+   *
    * (Is equivalent to writing the size of the data until SkipTargetHere() to stream)
    *
    * \param short_skip_offset If skip offset will be smaller than 256, can be set to true, to make stream 3 bytes shorter
@@ -484,11 +934,19 @@ public:
 
   void WriteString(const char* s)
   {
+    if (string_encoding == tStringEncoding::LENGTH_PREFIXED)
+    {
+      size_t length = strlen(s);
+      WriteEncodedNumber<uint32_t>(length);
+      Write(const_cast<char*>(s), length);
+      return;
+    }
     Write(const_cast<char*>(s), strlen(s) + 1);
   }
 
   /*!
-   * Write null-terminated string (8 Bit Characters - Suited for ASCII)
+   * Write string (8 Bit Characters - Suited for ASCII):
+   * null-terminated or length-prefixed - depending on string encoding (see SetStringEncoding)
    *
    * \param s String
    */
@@ -501,17 +959,236 @@ public:
    * Write string (8 Bit Characters - Suited for ASCII)
    *
    * \param s String
-   * \param terminate Terminate string with zero?
+   * \param terminate Terminate string with zero? (or prefix it with its length - depending on string encoding; see SetStringEncoding)
    */
   void WriteString(const std::string& s, bool terminate);
 
+//----------------------------------------------------------------------
+// Protected methods
+//----------------------------------------------------------------------
+protected:
+
+  /*!
+   * Calls sink methods via the tSink interface (virtual calls).
+   * All stream operations that call the sink are implemented by the *Implementation() methods below - parameterized on how sink methods are called.
+   * This way, tStaticOutputStream shares this logic - with non-virtual calls to its sink (see tSinkOperations).
+   */
+  struct tVirtualSinkCalls
+  {
+    tSink* sink;
+
+    explicit tVirtualSinkCalls(tSink* sink) : sink(sink)
+    {}
+
+    inline void Close(tOutputStream& stream, tBufferInfo& buffer)
+    {
+      sink->Close(stream, buffer);
+    }
+    inline void DirectWrite(tOutputStream& stream, const tFixedBuffer& buffer, size_t offset, size_t len)
+    {
+      sink->DirectWrite(stream, buffer, offset, len);
+    }
+    inline bool DirectWriteSupport()
+    {
+      return sink->DirectWriteSupport();
+    }
+    inline void Flush(tOutputStream& stream, const tBufferInfo& buffer)
+    {
+      sink->Flush(stream, buffer);
+    }
+    inline size_t GetDirectWriteThreshold(size_t buffer_capacity)
+    {
+      return sink->GetDirectWriteThreshold(buffer_capacity);
+    }
+    inline void Reset(tOutputStream& stream, tBufferInfo& buffer)
+    {
+      sink->Reset(stream, buffer);
+    }
+    inline bool Write(tOutputStream& stream, tBufferInfo& buffer, int write_size_hint)
+    {
+      return sink->Write(stream, buffer, write_size_hint);
+    }
+    inline bool WriteVectored(tOutputStream& stream, tBufferInfo& buffer, const tSink::tFragment* fragments, size_t fragment_count)
+    {
+      return sink->WriteVectored(stream, buffer, fragments, fragment_count);
+    }
+  };
+
+  /*!
+   * Stream operations that call the sink - instantiated for a specific way of calling sink methods (see GetSinkOperations()).
+   * Invoking an operation is a single indirect call - sink methods are then called as specified by the TSinkCalls type.
+   */
+  struct tSinkOperations
+  {
+    void (*close)(tOutputStream& stream);
+    void (*commit_data)(tOutputStream& stream, int add_size_hint);
+    void (*flush)(tOutputStream& stream);
+    void (*reset)(tOutputStream& stream);
+    void (*write_direct)(tOutputStream& stream, const tFixedBuffer& bb, size_t off, size_t len);
+  };
+
+  /*!
+   * \tparam TSinkCalls Type that calls sink methods (see tVirtualSinkCalls) - constructible from the stream's tSink pointer
+   * \return Stream operations that call sink methods via TSinkCalls
+   */
+  template <typename TSinkCalls>
+  static const tSinkOperations& GetSinkOperations()
+  {
+    static const tSinkOperations operations =
+    {
+      &CloseOperation<TSinkCalls>,
+      &CommitDataOperation<TSinkCalls>,
+      &FlushOperation<TSinkCalls>,
+      &ResetOperation<TSinkCalls>,
+      &WriteDirectOperation<TSinkCalls>
+    };
+    return operations;
+  }
+
+  /*!
+   * Implementation of Close()
+   *
+   * \param sink_calls Calls sink methods (see tVirtualSinkCalls)
+   */
+  template <typename TSinkCalls>
+  inline void CloseImplementation(TSinkCalls sink_calls)
+  {
+    if (!closed)
+    {
+      if (!marks.empty())
+      {
+        Rollback(tMark(0));
+      }
+      FlushImplementation(sink_calls);
+      sink_calls.Close(*this, buffer);
+    }
+    closed = true;
+  }
+
+  /*!
+   * Implementation of CommitData()
+   *
+   * \param sink_calls Calls sink methods (see tVirtualSinkCalls)
+   * \param add_size_hint Hint at how many additional bytes we want to write; -1 indicates manual flush without need for size increase
+   */
+  template <typename TSinkCalls>
+  inline void CommitDataImplementation(TSinkCalls sink_calls, int add_size_hint)
+  {
+    if (GetPosition() > 0 || add_size_hint > 0)  // with empty buffer, calling sink is only necessary if more capacity is required
+    {
+      if (marks.empty())
+      {
+        WriteBufferToSink(sink_calls, add_size_hint);
+      }
+      else
+      {
+        // data after oldest open mark must not reach sink: only write data before it - and keep the rest in (possibly new) buffer
+        size_t marked_size = buffer.position - marks.front();
+        tFixedBuffer* old_buffer = buffer.buffer;
+        buffer.position = marks.front();
+        bool invalidated = sink_calls.Write(*this, buffer, add_size_hint < 0 ? add_size_hint : add_size_hint + static_cast<int>(marked_size));
+        MoveMarkedData(old_buffer, marked_size, invalidated, add_size_hint);
+      }
+      assert(add_size_hint < 0 || buffer.Remaining() >= 8);
+      sink_direct_write_threshold = sink_calls.GetDirectWriteThreshold(buffer.Capacity());
+    }
+  }
+
+  /*!
+   * Implementation of Flush()
+   *
+   * \param sink_calls Calls sink methods (see tVirtualSinkCalls)
+   */
+  template <typename TSinkCalls>
+  inline void FlushImplementation(TSinkCalls sink_calls)
+  {
+    if (!marks.empty())
+    {
+      // flush sink - excluding data after open marks
+      CommitDataImplementation(sink_calls, -1);
+      size_t position = buffer.position;
+      buffer.position = marks.front();
+      sink_calls.Flush(*this, buffer);
+      buffer.position = position;
+      return;
+    }
+    if (GetPosition() > 0)
+    {
+      WriteBufferToSink(sink_calls, -1);
+      sink_direct_write_threshold = sink_calls.GetDirectWriteThreshold(buffer.Capacity());
+    }
+    sink_calls.Flush(*this, buffer);
+  }
+
+  /*!
+   * Implementation of Reset()
+   *
+   * \param sink_calls Calls sink methods (see tVirtualSinkCalls)
+   */
+  template <typename TSinkCalls>
+  inline void ResetImplementation(TSinkCalls sink_calls)
+  {
+    marks.clear();
+    skip_offset_placeholders.clear();
+    sink_calls.Reset(*this, buffer);
+    assert((buffer.Remaining() >= 8));
+    closed = false;
+    sink_direct_write_threshold = sink_calls.GetDirectWriteThreshold(buffer.Capacity());
+    direct_write_support = sink_calls.DirectWriteSupport();
+  }
+
+  /*!
+   * Writes complete buffer to sink (there must not be any open marks)
+   *
+   * \param sink_calls Calls sink methods (see tVirtualSinkCalls)
+   * \param write_size_hint Hint at how many additional bytes we want to write; -1 indicates manual flush without need for size increase
+   */
+  template <typename TSinkCalls>
+  inline void WriteBufferToSink(TSinkCalls sink_calls, int write_size_hint)
+  {
+    assert(marks.empty());
+    size_t position = buffer.position;
+    if (sink_calls.Write(*this, buffer, write_size_hint))
+    {
+      assert(skip_offset_placeholders.empty());
+    }
+    buffer_offset += static_cast<int64_t>(position) - static_cast<int64_t>(buffer.position);
+  }
+
+  /*!
+   * Forwards block to sink directly - together with buffered data (there must not be any open marks or skip offset placeholders)
+   *
+   * \param sink_calls Calls sink methods (see tVirtualSinkCalls)
+   * \param bb Buffer containing block
+   * \param off Offset of block in buffer
+   * \param len Length of block
+   */
+  template <typename TSinkCalls>
+  inline void WriteDirectImplementation(TSinkCalls sink_calls, const tFixedBuffer& bb, size_t off, size_t len)
+  {
+    if (GetPosition() > 0)
+    {
+      // write buffered data and block together
+      tSink::tFragment fragment = { &bb, off, len };
+      size_t position = buffer.position;
+      sink_calls.WriteVectored(*this, buffer, &fragment, 1);
+      buffer_offset += static_cast<int64_t>(position + len) - static_cast<int64_t>(buffer.position);
+      sink_direct_write_threshold = sink_calls.GetDirectWriteThreshold(buffer.Capacity());
+    }
+    else
+    {
+      sink_calls.DirectWrite(*this, bb, off, len);
+      buffer_offset += len;
+    }
+  }
+
 //----------------------------------------------------------------------
 // Private fields and methods
 //----------------------------------------------------------------------
 private:
 
-  /*! Committed buffers are buffered/copied (not forwarded directly), when smaller than 1/(2^n) of buffer capacity */
-  static const double cBUFFER_COPY_FRACTION;
+  template <typename TSink>
+  friend class tStaticOutputStream;
 
   /*! Source that determines where buffers that are written to come from and how they are handled */
   rrlib::serialization::tSink* sink;
@@ -525,14 +1202,39 @@ private:
   /*! Buffer that is currently written to - is managed by sink */
   tBufferInfo buffer;
 
-  /*! -1 by default - buffer position when a skip offset placeholder has been set/written */
-  int64_t cur_skip_offset_placeholder;
+  /*! Absolute position of current buffer's first byte in stream (number of bytes written before it - apart from an arbitrary constant) */
+  int64_t buffer_offset;
+
+  /*! Skip offset placeholder that has been set/written */
+  struct tSkipOffsetPlaceholder
+  {
+    /*! Absolute position of placeholder in stream (see GetAbsolutePosition()) */
+    int64_t position;
+
+    /*! Buffer that placeholder was written to (the skip offset is written there - also if the sink has provided a new buffer meanwhile) */
+    tFixedBuffer* buffer;
+
+    /*! Position of placeholder in this buffer */
+    size_t buffer_position;
 
-  /*! if true, indicates that only 1 byte has been reserved for skip offset placeholder */
-  bool short_skip_offset;
+    /*! if true, indicates that only 1 byte has been reserved for skip offset placeholder */
+    bool short_skip_offset;
+  };
 
-  /*! hole Buffers are only buffered/copied, when they are smaller than this */
-  size_t buffer_copy_fraction;
+  /*! Stack of skip offset placeholders whose targets have not been set yet (innermost last) */
+  std::vector<tSkipOffsetPlaceholder> skip_offset_placeholders;
+
+  /*! Buffer positions of open marks (innermost last) */
+  std::vector<size_t> marks;
+
+  /*! Direct write threshold preferred by sink for current buffer (see tSink::GetDirectWriteThreshold()) */
+  size_t sink_direct_write_threshold;
+
+  /*! Fixed direct write threshold set via SetDirectWriteThreshold() - zero if threshold is adapted */
+  size_t fixed_direct_write_threshold;
+
+  /*! Moving average of the sizes of blocks written via Write(const tFixedBuffer&, ...) - excluding small blocks (see GetDirectWriteThreshold()) */
+  size_t average_block_size;
 
   /*! Is direct write support available with this sink? */
   bool direct_write_support;
@@ -543,6 +1245,15 @@ private:
   /*! Custom type encoder */
   tTypeEncoder* custom_encoder;
 
+  /*! Encoding of container sizes, enum indices and numbers written with WriteEncodedNumber */
+  tIntegerEncoding integer_encoding;
+
+  /*! Write std::vector<bool> in bit-packed format? */
+  bool packed_bool_vectors;
+
+  /*! Encoding of strings written with WriteString */
+  tStringEncoding string_encoding;
+
 
   /*!
    * Immediately flush buffer if appropriate option is set
@@ -556,22 +1267,68 @@ private:
     }
   }
 
+  /*! Operations that call the sink (tStaticOutputStream uses variants with non-virtual calls) */
+  const tSinkOperations* sink_operations;
+
+
+  template <typename TSinkCalls>
+  static void CloseOperation(tOutputStream& stream)
+  {
+    stream.CloseImplementation(TSinkCalls(stream.sink));
+  }
+
+  template <typename TSinkCalls>
+  static void CommitDataOperation(tOutputStream& stream, int add_size_hint)
+  {
+    stream.CommitDataImplementation(TSinkCalls(stream.sink), add_size_hint);
+  }
+
+  template <typename TSinkCalls>
+  static void FlushOperation(tOutputStream& stream)
+  {
+    stream.FlushImplementation(TSinkCalls(stream.sink));
+  }
+
+  template <typename TSinkCalls>
+  static void ResetOperation(tOutputStream& stream)
+  {
+    stream.ResetImplementation(TSinkCalls(stream.sink));
+  }
+
+  template <typename TSinkCalls>
+  static void WriteDirectOperation(tOutputStream& stream, const tFixedBuffer& bb, size_t off, size_t len)
+  {
+    stream.WriteDirectImplementation(TSinkCalls(stream.sink), bb, off, len);
+  }
+
   /*!
    * Write current buffer contents to sink and clear buffer.
    *
    * \param add_size_hint Hint at how many additional bytes we want to write; -1 indicates manual flush without need for size increase
    */
-  void CommitData(int add_size_hint);
+  inline void CommitData(int add_size_hint)
+  {
+    sink_operations->commit_data(*this, add_size_hint);
+  }
 
   /*!
-   * \return Whole Buffers are only buffered/copied, when they are smaller than this
+   * \return Absolute position in stream (sum of bytes written; only differences are meaningful)
    */
-  inline size_t GetCopyFraction() const
+  inline int64_t GetAbsolutePosition() const
   {
-    assert((buffer_copy_fraction > 0));
-    return buffer_copy_fraction;
+    return buffer_offset + static_cast<int64_t>(buffer.position);
   }
 
+  /*!
+   * Moves data written after oldest open mark to position in buffer after sink was called (see CommitDataImplementation())
+   *
+   * \param old_buffer Buffer before sink was called
+   * \param marked_size Number of bytes written after oldest open mark
+   * \param invalidated Return value of sink's Write() method
+   * \param add_size_hint Hint at how many additional bytes we want to write; -1 indicates manual flush without need for size increase
+   */
+  void MoveMarkedData(tFixedBuffer* old_buffer, size_t marked_size, bool invalidated, int add_size_hint);
+
   /*!
    * \return Bytes remaining (for writing) in current internal buffer provided by the Sink
    */
@@ -694,6 +1451,7 @@ inline tOutputStream& operator<< (tOutputStream& stream, const util::tEnumBasedF
 template <typename T1, typename T2>
 inline tOutputStream& operator<< (tOutputStream& stream, const std::pair<T1, T2>& pair)
 {
+  stream.EnsureAdditionalCapacity(FixedSerializedSize<std::pair<T1, T2>>::value);  // no-op if size is not fixed
   stream << pair.first << pair.second;
   return stream;
 }
@@ -717,11 +1475,47 @@ struct tTupleSerializer < -1, TArgs... >
   {
   }
 };
+
+/*!
+ * Writes array of bulk-serializable values to stream (see tOutputStream::WriteNumbers()).
+ *
+ * \param stream Stream to write to
+ * \param values Pointer to first value
+ * \param count Number of values to write
+ */
+template <typename T>
+inline void WriteBulk(tOutputStream& stream, const T* values, size_t count)
+{
+  stream.WriteNumbers(values, count);
+}
+
+template <typename T, bool BULK_SERIALIZABLE = IsBulkSerializable<T>::value>
+struct tArraySerializer
+{
+  static void SerializeArray(tOutputStream& stream, const T* values, size_t count)
+  {
+    stream.EnsureAdditionalCapacity(count * FixedSerializedSize<T>::value);
+    for (size_t i = 0; i < count; i++)
+    {
+      stream << values[i];
+    }
+  }
+};
+
+template <typename T>
+struct tArraySerializer<T, true>
+{
+  static void SerializeArray(tOutputStream& stream, const T* values, size_t count)
+  {
+    WriteBulk(stream, values, count);
+  }
+};
 } // namespace internal
 
 template <typename ... TArgs>
 inline tOutputStream& operator<< (tOutputStream& stream, const std::tuple<TArgs...>& tuple)
 {
+  stream.EnsureAdditionalCapacity(FixedSerializedSize<std::tuple<TArgs...>>::value);
   internal::tTupleSerializer < static_cast<int>(std::tuple_size<std::tuple<TArgs...>>::value) - 1, TArgs... >::SerializeTuple(stream, tuple);
   return stream;
 }
@@ -729,10 +1523,7 @@ inline tOutputStream& operator<< (tOutputStream& stream, const std::tuple<TArgs.
 template <typename T, size_t N>
 inline tOutputStream& operator<< (tOutputStream& stream, const std::array<T, N>& array)
 {
-  for (const T & element : array)
-  {
-    stream << element;
-  }
+  internal::tArraySerializer<T>::SerializeArray(stream, array.data(), N);
   return stream;
 }
 
@@ -0,0 +1,169 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/serialization/tReceiveBuffer.cpp
+ *
+ * \author  agent
+ *
+ * \date    2026-10-16
+ *
+ */
+//----------------------------------------------------------------------
+#include "rrlib/serialization/tReceiveBuffer.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <algorithm>
+#include <string>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/serialization/tBufferInfo.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace serialization
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+const size_t tReceiveBuffer::cDEFAULT_SIZE;
+
+tReceiveBuffer::tReceiveBuffer(size_t initial_capacity) :
+  data(),
+  data_position(0),
+  view_position(0),
+  discard_position(0),
+  view()
+{
+  data.reserve(initial_capacity);
+}
+
+void tReceiveBuffer::Append(const void* new_data, size_t size)
+{
+  if (data.size() + size > data.capacity())
+  {
+    // remove discarded data (but no data in input stream's current buffer) before growing buffer
+    int64_t keep_position = std::min(discard_position, view_position);
+    if (keep_position > data_position)
+    {
+      data.erase(data.begin(), data.begin() + (keep_position - data_position));
+      data_position = keep_position;
+    }
+  }
+  data.insert(data.end(), static_cast<const char*>(new_data), static_cast<const char*>(new_data) + size);
+  UpdateView();
+}
+
+void tReceiveBuffer::Close(tInputStream& input_stream, tBufferInfo& buffer)
+{
+  buffer.Reset();
+}
+
+void tReceiveBuffer::DirectRead(tInputStream& input_stream, tFixedBuffer& buffer, size_t offset, size_t len)
+{
+  throw std::logic_error("Unsupported - shouldn't be called");
+}
+
+void tReceiveBuffer::Discard(int64_t position)
+{
+  assert(position <= GetEndPosition());
+  discard_position = std::max(discard_position, position);
+}
+
+bool tReceiveBuffer::MoreDataAvailable(tInputStream& input_stream, tBufferInfo& buffer)
+{
+  return view_position + static_cast<int64_t>(buffer.end) < GetEndPosition();
+}
+
+void tReceiveBuffer::Read(tInputStream& input_stream, tBufferInfo& buffer, size_t len)
+{
+  int64_t next_position = view_position + buffer.end;
+  if (next_position >= GetEndPosition() || static_cast<size_t>(GetEndPosition() - next_position) < len)
+  {
+    throw tNeedMoreDataException(next_position + len);
+  }
+  view_position = next_position;
+  SetView(buffer);
+}
+
+void tReceiveBuffer::Reset(tInputStream& input_stream, tBufferInfo& buffer)
+{
+  // positions are relative to the input stream - which starts at zero
+  data_position = 0;
+  view_position = 0;
+  discard_position = 0;
+  SetView(buffer);
+}
+
+void tReceiveBuffer::Seek(tInputStream& input_stream, tBufferInfo& buffer, uint64_t position)
+{
+  if (static_cast<int64_t>(position) < data_position || static_cast<int64_t>(position) > GetEndPosition())
+  {
+    throw std::out_of_range("Position out of range: " + std::to_string(position));
+  }
+  view_position = position;
+  SetView(buffer);
+}
+
+void tReceiveBuffer::SetView(tBufferInfo& buffer)
+{
+  UpdateView();
+  buffer.buffer = &view;
+  buffer.position = 0u;
+  buffer.SetRange(0u, view.Capacity());
+}
+
+void tReceiveBuffer::UpdateView()
+{
+  assert(view_position >= data_position && view_position <= GetEndPosition());
+  view = tFixedBuffer(data.data() + (view_position - data_position), GetEndPosition() - view_position);
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
@@ -0,0 +1,207 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/serialization/tReceiveBuffer.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tReceiveBuffer
+ *
+ * \b tReceiveBuffer
+ *
+ * Non-blocking source for data that arrives in pieces (e.g. from a non-blocking socket).
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__serialization__tReceiveBuffer_h__
+#define __rrlib__serialization__tReceiveBuffer_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <vector>
+#include "rrlib/util/tNoncopyable.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/serialization/tFixedBuffer.h"
+#include "rrlib/serialization/tSource.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace serialization
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Non-blocking source for incrementally arriving data
+/*!
+ * Non-blocking source for data that arrives in pieces (e.g. from a non-blocking socket).
+ * Received data is added with Append(). When an input stream attempts to read
+ * more data than has arrived yet, a tNeedMoreDataException is thrown.
+ *
+ * Data is retained until it is discarded explicitly. Together with input stream
+ * checkpoints, this allows deserializing partially received messages in an event loop:
+ *
+ *   receive_buffer.Append(data, size);
+ *   while (stream.MoreDataAvailable())
+ *   {
+ *     tInputStream::tCheckpoint checkpoint = stream.Checkpoint();
+ *     try
+ *     {
+ *       stream >> message;
+ *     }
+ *     catch (const tNeedMoreDataException&)
+ *     {
+ *       stream.RestoreCheckpoint(checkpoint);  // retry when more data has arrived
+ *       break;
+ *     }
+ *     receive_buffer.Discard(stream.GetAbsoluteReadPosition());
+ *     ...
+ *   }
+ *
+ * Positions are absolute positions of the input stream that reads from this buffer (see tInputStream::GetAbsoluteReadPosition()).
+ * This buffer may only be used by one input stream at a time.
+ */
+class tReceiveBuffer : public tSource, private util::tNoncopyable
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*! Default initial capacity */
+  static const size_t cDEFAULT_SIZE = 8192u;
+
+  /*!
+   * \param initial_capacity Initial capacity of buffer (grows when required)
+   */
+  tReceiveBuffer(size_t initial_capacity = cDEFAULT_SIZE);
+
+  /*!
+   * Adds received data to buffer
+   *
+   * \param data Pointer to data
+   * \param size Number of bytes
+   */
+  void Append(const void* data, size_t size);
+
+  /*!
+   * Allows discarding data before the specified position - as it is no longer needed
+   * (typically the position after the last message that was deserialized completely).
+   * Memory is reclaimed when more data is appended.
+   *
+   * \param position Absolute position in input stream
+   */
+  void Discard(int64_t position);
+
+  /*!
+   * \return Absolute position after last byte that was received
+   */
+  int64_t GetEndPosition() const
+  {
+    return data_position + data.size();
+  }
+
+  /*!
+   * \return Number of bytes currently retained in buffer
+   */
+  size_t GetSize() const
+  {
+    return data.size();
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Retained data */
+  std::vector<char> data;
+
+  /*! Absolute position of first byte in 'data' */
+  int64_t data_position;
+
+  /*! Absolute position of first byte of buffer that is currently provided to input stream */
+  int64_t view_position;
+
+  /*! Data before this absolute position may be discarded */
+  int64_t discard_position;
+
+  /*! Buffer that is currently provided to input stream (wraps part of 'data') */
+  tFixedBuffer view;
+
+
+  virtual void Close(tInputStream& input_stream, tBufferInfo& buffer) override;
+
+  virtual void DirectRead(tInputStream& input_stream, tFixedBuffer& buffer, size_t offset, size_t len) override;
+
+  virtual bool DirectReadSupport() const override
+  {
+    return false;
+  }
+
+  virtual bool MoreDataAvailable(tInputStream& input_stream, tBufferInfo& buffer) override;
+
+  virtual void Read(tInputStream& input_stream, tBufferInfo& buffer, size_t len) override;
+
+  virtual void Reset(tInputStream& input_stream, tBufferInfo& buffer) override;
+
+  virtual void Seek(tInputStream& input_stream, tBufferInfo& buffer, uint64_t position) override;
+
+  virtual bool SeekSupport() override
+  {
+    return true;
+  }
+
+  /*!
+   * Provides data from view_position to end of data to input stream
+   *
+   * \param buffer Buffer info of input stream
+   */
+  void SetView(tBufferInfo& buffer);
+
+  /*!
+   * Updates wrapped memory of view (e.g. after 'data' was reallocated)
+   */
+  void UpdateView();
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+
+#endif
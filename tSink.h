@@ -80,6 +80,21 @@ class tSink
 //----------------------------------------------------------------------
 public:
 
+  /*!
+   * Fragment of data to write (see WriteVectored())
+   */
+  struct tFragment
+  {
+    /*! Buffer that contains data */
+    const tFixedBuffer* buffer;
+
+    /*! Offset of data in buffer */
+    size_t offset;
+
+    /*! Number of bytes to write */
+    size_t length;
+  };
+
   virtual ~tSink() {}
 
   /*!
@@ -116,6 +131,19 @@ public:
    */
   virtual void Flush(tOutputStream& output_stream, const tBufferInfo& buffer) = 0;
 
+  /*!
+   * Preferred threshold for forwarding blocks to DirectWrite():
+   * Smaller blocks are copied to the stream's buffer, blocks of at least this size are forwarded.
+   * (only relevant for sinks with direct write support; output streams may raise it, if they observe that blocks of similar size are written repeatedly)
+   *
+   * \param buffer_capacity Capacity of the stream's current buffer
+   * \return Threshold in bytes
+   */
+  virtual size_t GetDirectWriteThreshold(size_t buffer_capacity)
+  {
+    return buffer_capacity / 4;
+  }
+
   /*!
    * Reset sink for writing content (again)
    * (may only be supported once - typically the case with streams)
@@ -129,13 +157,39 @@ public:
    * Write/flush data to sink/"device".
    * Bytes from buffer "limit" to buffer position are written.
    *
+   * Bytes after buffer position (up to buffer end) may contain data written after open marks (see tOutputStream::Mark()).
+   * If the sink keeps the same buffer object, it must keep these bytes at their offset (also if it reallocates memory).
+   * If it provides another buffer object, the previous one must remain valid until the next call to the sink.
+   *
    * \param output_stream Stream that requests operation
    * \param buffer Buffer that is managed and contains data. Needs to be cleared/reset/replaced by this method.
    * \param write_size_hint Hint about how much data we plan to write additionally (mostly makes sense, when there's no direct read support); -1 indicates manual flush without need for size increase
-   * \return Invalidate any Placeholder? (usually true, when buffer changes)
+   * \return Invalidate any Placeholder? (true, if data written so far may no longer be modified: skip offsets are written to the buffer that contains the placeholder - also after the sink has provided a new buffer)
    */
   virtual bool Write(tOutputStream& output_stream, tBufferInfo& buffer, int write_size_hint) = 0;
 
+  /*!
+   * Write data in buffer - followed by the specified fragments - to sink/"device" in one operation.
+   * (optional optimization for sinks with direct write support: e.g. buffered data and a large block can be written with a single system call)
+   * Like Write(), this method needs to clear/reset/replace buffer.
+   * The default implementation calls Write() and DirectWrite().
+   *
+   * \param output_stream Stream that requests operation
+   * \param buffer Buffer that is managed and contains data. Needs to be cleared/reset/replaced by this method.
+   * \param fragments Fragments to write after the data in buffer
+   * \param fragment_count Number of fragments
+   * \return Invalidate any Placeholder? (usually true, when buffer changes)
+   */
+  virtual bool WriteVectored(tOutputStream& output_stream, tBufferInfo& buffer, const tFragment* fragments, size_t fragment_count)
+  {
+    bool result = Write(output_stream, buffer, -1);
+    for (size_t i = 0; i < fragment_count; i++)
+    {
+      DirectWrite(output_stream, *fragments[i].buffer, fragments[i].offset, fragments[i].length);
+    }
+    return result;
+  }
+
 };
 
 //----------------------------------------------------------------------
@@ -42,6 +42,9 @@
 //----------------------------------------------------------------------
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
+#include <stdexcept>
+#include <cstdint>
+#include "rrlib/time/time.h"
 
 //----------------------------------------------------------------------
 // Internal includes with ""
@@ -65,6 +68,38 @@ class tFixedBuffer;
 //----------------------------------------------------------------------
 // Class declaration
 //----------------------------------------------------------------------
+//! Exception thrown by non-blocking sources
+/*!
+ * Thrown by non-blocking sources (e.g. tReceiveBuffer), when more data is to be read than has arrived yet.
+ * The input stream can be restored to a checkpoint that was created before (see tInputStream::RestoreCheckpoint())
+ * in order to retry reading when more data has arrived.
+ */
+class tNeedMoreDataException : public std::runtime_error
+{
+public:
+
+  /*!
+   * \param required_position Absolute stream position up to which data must have arrived before reading can succeed (0 if unknown)
+   */
+  tNeedMoreDataException(int64_t required_position = 0) :
+    std::runtime_error("More data required"),
+    required_position(required_position)
+  {}
+
+  /*!
+   * \return Absolute stream position up to which data must have arrived before reading can succeed (0 if unknown)
+   */
+  int64_t GetRequiredPosition() const
+  {
+    return required_position;
+  }
+
+private:
+
+  /*! Absolute stream position up to which data must have arrived before reading can succeed */
+  int64_t required_position;
+};
+
 //! Abstract interface for data sources
 /*!
  * Abstract data source interface that can be used with binary input streams
@@ -159,6 +194,34 @@ public:
     */
   virtual bool SeekSupport() = 0;
 
+  /*!
+   * Blocks until more data is available or the specified timeout has passed.
+   * (optional operation - see WaitForDataSupport())
+   *
+   * Input streams with a timeout set call this instead of polling MoreDataAvailable().
+   * Sources that are notified when data arrives (e.g. via condition variable or
+   * file descriptor readiness) should implement this - so that data is processed without delay.
+   * Returning early (e.g. on spurious wakeups) is allowed.
+   *
+   * \param input_stream tInputStream that requests operation.
+   * \param buffer Current buffer (managed by source)
+   * \param timeout Maximum time to block
+   * \return Is more data available?
+   */
+  virtual bool WaitForData(tInputStream& input_stream, tBufferInfo& buffer, const rrlib::time::tDuration& timeout)
+  {
+    return MoreDataAvailable(input_stream, buffer);
+  }
+
+  /*!
+   * \return Does source support blocking until data is available (see WaitForData())?
+   * (otherwise, input streams with a timeout set poll MoreDataAvailable())
+   */
+  virtual bool WaitForDataSupport()
+  {
+    return false;
+  }
+
 };
 
 //----------------------------------------------------------------------
@@ -0,0 +1,173 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    rrlib/serialization/tStaticOutputStream.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-16
+ *
+ * \brief   Contains tStaticOutputStream
+ *
+ * \b tStaticOutputStream
+ *
+ * Binary output stream that is statically bound to a sink type.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__serialization__tStaticOutputStream_h__
+#define __rrlib__serialization__tStaticOutputStream_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/serialization/tOutputStream.h"
+#include "rrlib/serialization/tMemoryBuffer.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace serialization
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Binary output stream with statically bound sink
+/*!
+ * Binary output stream that writes to a sink of type TSink.
+ *
+ * As the sink type is known at compile time, all stream operations that call the sink - committing data
+ * when the buffer is full, forwarding large blocks, Flush(), Close() and Reset() - call the sink's methods
+ * directly (non-virtual calls that can be inlined) instead of going through the tSink interface.
+ * This reduces overhead when serializing many small objects, e.g. to a tMemoryBuffer:
+ *
+ *  tMemoryBuffer buffer;
+ *  tStaticOutputStream<tMemoryBuffer> os(buffer);
+ *  os << message;
+ *  os.Close();
+ *
+ * Since it is an output stream, all stream operators are available.
+ * If the sink is replaced via tOutputStream::Reset(tSink&), the stream calls the new sink via the tSink interface.
+ *
+ * TSink needs to declare tStaticOutputStream<TSink> as a friend (tMemoryBuffer does).
+ */
+template <typename TSink>
+class tStaticOutputStream : public tOutputStream
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*!
+   * \param sink Sink to write to
+   * \param encoding Data type encoding to use when data types from rrlib::rtti are serialized (optional)
+   * \param integer_encoding Encoding of container sizes, enum indices and numbers written with WriteEncodedNumber (optional)
+   */
+  tStaticOutputStream(TSink& sink, tTypeEncoding encoding = tTypeEncoding::LOCAL_UIDS, tIntegerEncoding integer_encoding = tIntegerEncoding::FIXED) :
+    tOutputStream(encoding, integer_encoding)
+  {
+    Reset(sink);
+  }
+
+  using tOutputStream::Reset;
+
+  /*!
+   * Use buffer with different sink (closes attached one)
+   *
+   * \param sink New Sink to use
+   */
+  inline void Reset(TSink& sink)
+  {
+    Close();
+    this->sink = &sink;
+    sink_operations = &GetSinkOperations<tStaticSinkCalls>();
+    Reset();
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Calls sink methods non-virtually (see tOutputStream::tVirtualSinkCalls) */
+  struct tStaticSinkCalls
+  {
+    TSink* sink;
+
+    explicit tStaticSinkCalls(tSink* sink) : sink(static_cast<TSink*>(sink))
+    {}
+
+    inline void Close(tOutputStream& stream, tBufferInfo& buffer)
+    {
+      sink->TSink::Close(stream, buffer);
+    }
+    inline void DirectWrite(tOutputStream& stream, const tFixedBuffer& buffer, size_t offset, size_t len)
+    {
+      sink->TSink::DirectWrite(stream, buffer, offset, len);
+    }
+    inline bool DirectWriteSupport()
+    {
+      return sink->TSink::DirectWriteSupport();
+    }
+    inline void Flush(tOutputStream& stream, const tBufferInfo& buffer)
+    {
+      sink->TSink::Flush(stream, buffer);
+    }
+    inline size_t GetDirectWriteThreshold(size_t buffer_capacity)
+    {
+      return sink->TSink::GetDirectWriteThreshold(buffer_capacity);
+    }
+    inline void Reset(tOutputStream& stream, tBufferInfo& buffer)
+    {
+      sink->TSink::Reset(stream, buffer);
+    }
+    inline bool Write(tOutputStream& stream, tBufferInfo& buffer, int write_size_hint)
+    {
+      return sink->TSink::Write(stream, buffer, write_size_hint);
+    }
+    inline bool WriteVectored(tOutputStream& stream, tBufferInfo& buffer, const tSink::tFragment* fragments, size_t fragment_count)
+    {
+      return sink->TSink::WriteVectored(stream, buffer, fragments, fragment_count);
+    }
+  };
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+
+#endif
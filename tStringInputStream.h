@@ -48,6 +48,7 @@
 //----------------------------------------------------------------------
 // Internal includes with ""
 //----------------------------------------------------------------------
+#include "rrlib/serialization/detail/tEnumValueIndex.h"
 
 //----------------------------------------------------------------------
 // Namespace declaration
@@ -175,12 +176,10 @@ public:
       // check whether number is valid
       if (enum_strings.non_standard_values)
       {
-        for (size_t i = 0; i < enum_strings.size; i++)
+        size_t index = 0;
+        if (detail::tEnumValueIndex<ENUM>::Find(static_cast<ENUM>(n), index))
         {
-          if (static_cast<ENUM>(n) == static_cast<const ENUM*>(enum_strings.non_standard_values)[i])
-          {
-            return static_cast<ENUM>(n);
-          }
+          return static_cast<ENUM>(n);
         }
         throw std::runtime_error("Number not a valid enum constant");
       }
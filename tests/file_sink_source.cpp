@@ -31,14 +31,18 @@
 //----------------------------------------------------------------------
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
+#include <array>
 #include <cstdlib>
 #include <iostream>
+#include <list>
+#include <tuple>
 
 #include "rrlib/util/tUnitTestSuite.h"
 
 //----------------------------------------------------------------------
 // Internal includes with ""
 //----------------------------------------------------------------------
+#include "rrlib/serialization/serialization.h"
 #include "rrlib/serialization/tFileSink.h"
 #include "rrlib/serialization/tFileSource.h"
 #include "rrlib/serialization/tOutputStream.h"
@@ -83,6 +87,13 @@ class TestFileSinkSource : public util::tUnitTestSuite
   RRLIB_UNIT_TESTS_ADD_TEST(TestSinkUnwritable);
   RRLIB_UNIT_TESTS_ADD_TEST(TestSourceUnreadable);
   RRLIB_UNIT_TESTS_ADD_TEST(TestSinkSource);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestMarkRollback);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestLargeBlocks);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestViews);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestSkipString);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestContiguousWindow);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestFixedSizeValues);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestLazy);
   RRLIB_UNIT_TESTS_END_SUITE;
 
 private:
@@ -123,6 +134,282 @@ private:
     RRLIB_UNIT_TESTS_EQUALITY_MESSAGE("Written and read string must be equal", test_string, test_string_);
   }
 
+  void TestLargeBlocks()
+  {
+    std::string path = rrlib::util::fileio::CreateTempFile();
+    std::vector<std::string> blocks;
+    for (int i = 0; i < 20; i++)
+    {
+      blocks.emplace_back(i * 200, static_cast<char>('a' + i));
+    }
+
+    // small buffered data (block size) and large blocks are written together
+    tFileSink sink(path, 1024);
+    tOutputStream os(sink);
+    for (auto & block : blocks)
+    {
+      os.WriteInt(block.length());
+      os.Write(block.data(), block.length());
+    }
+    os.Close();
+
+    tFileSource src(path);
+    tInputStream is(src);
+    for (auto & block : blocks)
+    {
+      std::string read_block(is.ReadInt(), ' ');
+      is.ReadFully(&read_block[0], read_block.length());
+      RRLIB_UNIT_TESTS_EQUALITY_MESSAGE("Written and read block must be equal", block, read_block);
+    }
+    RRLIB_UNIT_TESTS_ASSERT(!is.MoreDataAvailable());
+  }
+
+  void TestViews()
+  {
+    std::string path = rrlib::util::fileio::CreateTempFile();
+    tFileSink sink(path);
+    tOutputStream os(sink);
+    for (int i = 0; i < 100; i++)
+    {
+      os << std::string(i * 3, static_cast<char>('a' + i % 26));
+      os.Write(std::string(i, 'x').data(), i);
+    }
+    os.Close();
+
+    // small source buffer: many strings and blocks cross buffer boundaries
+    tFileSource src(path, 64);
+    tInputStream is(src);
+    for (int i = 0; i < 100; i++)
+    {
+      RRLIB_UNIT_TESTS_ASSERT_MESSAGE("Viewed string must be correct", is.ReadStringView() == std::string(i * 3, static_cast<char>('a' + i % 26)));
+      RRLIB_UNIT_TESTS_EQUALITY_MESSAGE("Viewed bytes must be correct", std::string(i, 'x'), is.ReadBytesView(i).ToString());
+    }
+    RRLIB_UNIT_TESTS_ASSERT(!is.MoreDataAvailable());
+  }
+
+  void TestSkipString()
+  {
+    for (tStringEncoding string_encoding : { tStringEncoding::NULL_TERMINATED, tStringEncoding::LENGTH_PREFIXED })
+    {
+      std::string path = rrlib::util::fileio::CreateTempFile();
+      tFileSink sink(path);
+      tOutputStream os(sink);
+      os.SetStringEncoding(string_encoding);
+      for (int i = 0; i < 100; i++)
+      {
+        os << std::string(i * 5, 'x') << i;
+      }
+      os.Close();
+
+      // small source buffer: many strings cross buffer boundaries
+      tFileSource src(path, 64);
+      tInputStream is(src);
+      is.SetStringEncoding(string_encoding);
+      for (int i = 0; i < 100; i++)
+      {
+        is.SkipString();
+        RRLIB_UNIT_TESTS_EQUALITY_MESSAGE("Integer after skipped string must be read", i, is.ReadInt());
+      }
+      RRLIB_UNIT_TESTS_ASSERT(!is.MoreDataAvailable());
+    }
+  }
+
+  void TestContiguousWindow()
+  {
+    std::string path = rrlib::util::fileio::CreateTempFile();
+    tFileSink sink(path);
+    tOutputStream os(sink);
+    std::vector<int> header(50);
+    for (int i = 0; i < 20; i++)
+    {
+      for (size_t j = 0; j < header.size(); j++)
+      {
+        header[j] = i * 1000 + j;
+      }
+      os.WriteNumbers(header.data(), header.size());
+      os.WriteByte(i);
+    }
+    os.Close();
+
+    // small source buffer: windows of 200 bytes cross several buffer boundaries
+    tFileSource src(path, 64);
+    tInputStream is(src);
+    for (int i = 0; i < 20; i++)
+    {
+      int64_t position = is.GetAbsoluteReadPosition();
+      const char* window = is.PeekWindow(header.size() * 4 - (i % 2 ? 0 : 2));
+      for (size_t j = 0; j < header.size(); j += 7)
+      {
+        int value = static_cast<uint8_t>(window[j * 4]) | (static_cast<uint8_t>(window[j * 4 + 1]) << 8);
+        RRLIB_UNIT_TESTS_EQUALITY_MESSAGE("Window must contain header", static_cast<int>((i * 1000 + j) & 0xFFFF), value);
+      }
+      RRLIB_UNIT_TESTS_EQUALITY_MESSAGE("Peeking must not forward read position", position, is.GetAbsoluteReadPosition());
+      if (i % 2)
+      {
+        is.Skip(header.size() * 4);
+      }
+      else
+      {
+        // read values (last one crosses end of window)
+        is.Skip(header.size() * 4 - 8);
+        RRLIB_UNIT_TESTS_EQUALITY(static_cast<int>(i * 1000 + header.size() - 2), is.ReadInt());
+        RRLIB_UNIT_TESTS_EQUALITY(static_cast<int>(i * 1000 + header.size() - 1), is.ReadInt());
+      }
+      RRLIB_UNIT_TESTS_EQUALITY(position + static_cast<int64_t>(header.size() * 4), is.GetAbsoluteReadPosition());
+      RRLIB_UNIT_TESTS_EQUALITY(i, static_cast<int>(is.ReadByte()));
+    }
+    RRLIB_UNIT_TESTS_ASSERT(!is.MoreDataAvailable());
+
+    // windows can be viewed without copying
+    tInputStream is2(src);
+    is2.EnsureContiguous(header.size() * 4 + 1);
+    const char* window = is2.PeekWindow(header.size() * 4 + 1);
+    RRLIB_UNIT_TESTS_ASSERT(is2.ReadBytesView(header.size() * 4 + 1).Data() == window);
+    is2.Seek(3 * (header.size() * 4 + 1));
+    RRLIB_UNIT_TESTS_EQUALITY(3000, is2.ReadInt());
+
+    // small windows across buffer boundary followed by larger reads
+    std::string path2 = rrlib::util::fileio::CreateTempFile();
+    tFileSink sink2(path2);
+    tOutputStream os2(sink2);
+    for (int i = 0; i < 64; i++)
+    {
+      os2.WriteByte(i);
+    }
+    os2.Close();
+    tFileSource src2(path2, 20);
+    tInputStream is3(src2);
+    is3.Skip(19);
+    const char* small_window = is3.PeekWindow(2);
+    RRLIB_UNIT_TESTS_EQUALITY(19, static_cast<int>(small_window[0]));
+    RRLIB_UNIT_TESTS_EQUALITY(20, static_cast<int>(small_window[1]));
+    RRLIB_UNIT_TESTS_EQUALITY(0x16151413, is3.ReadInt());
+    RRLIB_UNIT_TESTS_EQUALITY(23, static_cast<int>(is3.ReadByte()));
+    is3.Skip(15);
+    RRLIB_UNIT_TESTS_EQUALITY(39, static_cast<int>(is3.Peek()));
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<int64_t>(0x2E2D2C2B2A292827), is3.ReadLong());
+    RRLIB_UNIT_TESTS_EQUALITY(47, static_cast<int>(is3.ReadByte()));
+  }
+
+  void TestFixedSizeValues()
+  {
+    typedef std::array<std::pair<int, int>, 4> tArray;  // larger than sink's buffer
+    typedef std::tuple<int16_t, float, std::array<int, 3>> tTuple;
+    std::vector<std::pair<uint8_t, int>> pairs;
+    std::vector<tArray> arrays(10);
+    std::list<std::pair<bool, double>> list;
+    for (int i = 0; i < 1000; i++)
+    {
+      pairs.emplace_back(i, -i);
+      list.emplace_back(i % 3 == 0, i * 0.25);
+      arrays[i % 10][i % 4] = std::make_pair(i, 2 * i);
+    }
+    tTuple tuple(7, 0.5f, std::array<int, 3> {{ 1, 2, 3 }});
+
+    // small buffers: ranges of values are split
+    std::string path = rrlib::util::fileio::CreateTempFile();
+    tFileSink sink(path, 20);
+    tOutputStream os(sink);
+    os << pairs << arrays << tuple << list << 0x1234;
+    os.Close();
+
+    tFileSource src(path, 20);
+    tInputStream is(src);
+    std::vector<std::pair<uint8_t, int>> pairs2;
+    std::vector<tArray> arrays2;
+    tTuple tuple2;
+    std::list<std::pair<bool, double>> list2;
+    is >> pairs2 >> arrays2 >> tuple2 >> list2;
+    RRLIB_UNIT_TESTS_ASSERT(pairs == pairs2);
+    RRLIB_UNIT_TESTS_ASSERT(arrays == arrays2);
+    RRLIB_UNIT_TESTS_ASSERT(tuple == tuple2);
+    RRLIB_UNIT_TESTS_ASSERT(list == list2);
+    RRLIB_UNIT_TESTS_EQUALITY(0x1234, is.ReadInt());
+
+    // skip whole ranges (after container size and const type flag)
+    tInputStream is2(src);
+    RRLIB_UNIT_TESTS_EQUALITY(1000, is2.ReadInt());
+    is2.ReadBoolean();
+    is2.SkipValues<std::pair<uint8_t, int>>(1000);
+    RRLIB_UNIT_TESTS_EQUALITY(10, is2.ReadInt());
+    is2.ReadBoolean();
+    is2.SkipValues<tArray>(10);
+    is2.SkipValues<tTuple>(1);
+    RRLIB_UNIT_TESTS_EQUALITY(1000, is2.ReadInt());
+    is2.ReadBoolean();
+    is2.SkipValues<std::pair<bool, double>>(999);
+    std::pair<bool, double> last;
+    is2 >> last;
+    RRLIB_UNIT_TESTS_ASSERT(last == list.back());
+    RRLIB_UNIT_TESTS_EQUALITY(0x1234, is2.ReadInt());
+    RRLIB_UNIT_TESTS_ASSERT(!is2.MoreDataAvailable());
+  }
+
+  void TestLazy()
+  {
+    std::string path = rrlib::util::fileio::CreateTempFile();
+    std::vector<int> values;
+    for (int i = 0; i < 10000; i++)
+    {
+      values.push_back(i * 3);
+    }
+
+    // serialized value is larger than sink's buffer
+    tFileSink sink(path, 1024);
+    tOutputStream os(sink);
+    os << tLazy<std::vector<int>>(values);
+    os.WriteInt(0x1234);
+    os.Close();
+
+    tFileSource src(path);
+    tInputStream is(src);
+    tLazy<std::vector<int>> lazy;
+    is >> lazy;
+    RRLIB_UNIT_TESTS_EQUALITY(0x1234, is.ReadInt());
+    RRLIB_UNIT_TESTS_ASSERT(!is.MoreDataAvailable());
+    RRLIB_UNIT_TESTS_ASSERT(lazy.Get() == values);
+  }
+
+  void TestMarkRollback()
+  {
+    std::string path = rrlib::util::fileio::CreateTempFile();
+
+    // write messages - every other one is rolled back (sink's buffer is flushed several times meanwhile)
+    tFileSink sink(path, 1024);
+    tOutputStream os(sink);
+    for (int i = 0; i < 100; i++)
+    {
+      auto mark = os.Mark();
+      os << i << std::string(i, 'x');
+      if (i % 2)
+      {
+        os.Rollback(mark);
+      }
+      else
+      {
+        os.Commit(mark);
+      }
+    }
+    auto mark = os.Mark();
+    RRLIB_UNIT_TESTS_EXCEPTION_MESSAGE("Marked data must fit into sink's buffer", os << std::string(5000, 'x'), std::length_error);
+    os.Rollback(mark);
+    os.WriteInt(0x1234);
+    os.Close();
+
+    tFileSource src(path);
+    tInputStream is(src);
+    for (int i = 0; i < 100; i += 2)
+    {
+      int test_int = -1;
+      std::string test_string;
+      is >> test_int >> test_string;
+      RRLIB_UNIT_TESTS_EQUALITY_MESSAGE("Committed integer must be read", i, test_int);
+      RRLIB_UNIT_TESTS_EQUALITY_MESSAGE("Committed string must be read", std::string(i, 'x'), test_string);
+    }
+    RRLIB_UNIT_TESTS_EQUALITY(0x1234, is.ReadInt());
+    RRLIB_UNIT_TESTS_ASSERT(!is.MoreDataAvailable());
+  }
+
 };
 
 RRLIB_UNIT_TESTS_REGISTER_SUITE(TestFileSinkSource);
@@ -33,15 +33,22 @@
 //----------------------------------------------------------------------
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
+#include <atomic>
+#include <condition_variable>
 #include <cstdlib>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <set>
+#include <thread>
 
 #include "rrlib/util/tUnitTestSuite.h"
 
 #include "rrlib/serialization/serialization.h"
+#include "rrlib/serialization/tAsyncInputStream.h"
 #include "rrlib/serialization/tInputStream.h"
 #include "rrlib/serialization/tOutputStream.h"
+#include "rrlib/serialization/tReceiveBuffer.h"
 
 //----------------------------------------------------------------------
 // Internal includes with ""
@@ -68,6 +75,10 @@ namespace serialization
 // We check this here so that not all programs using rrlib_serialization include <set> by default
 static_assert(IsSerializableContainer<std::set<std::string>>::value == true, "Incorrect trait implementation");
 static_assert(IsConstElementContainer<std::set<std::string>>::value == true, "Incorrect trait implementation");
+static_assert(FixedSerializedSize<long int>::value == 8, "Incorrect trait implementation");
+static_assert(FixedSerializedSize<std::pair<bool, double>>::value == 9, "Incorrect trait implementation");
+static_assert(FixedSerializedSize<std::tuple<int16_t, float, std::array<int, 3>>>::value == 18, "Incorrect trait implementation");
+static_assert(FixedSerializedSize<std::tuple<int, std::string>>::value == 0, "Incorrect trait implementation");
 
 //----------------------------------------------------------------------
 // Forward declarations / typedefs / enums
@@ -81,6 +92,86 @@ static_assert(IsConstElementContainer<std::set<std::string>>::value == true, "In
 // Implementation
 //----------------------------------------------------------------------
 
+/*!
+ * Source that receives data from another thread - and supports blocking until data arrives
+ */
+class tQueueSource : public tSource
+{
+public:
+
+  tQueueSource() : wait_calls(0) {}
+
+  void Push(const void* data, size_t size)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    pending.insert(pending.end(), static_cast<const char*>(data), static_cast<const char*>(data) + size);
+    data_available.notify_all();
+  }
+
+  /*! Number of WaitForData() calls */
+  int wait_calls;
+
+private:
+
+  std::mutex mutex;
+  std::condition_variable data_available;
+  std::vector<char> pending, current;
+  tFixedBuffer backend;
+
+  virtual void Close(tInputStream& input_stream, tBufferInfo& buffer) override
+  {
+    buffer.Reset();
+  }
+  virtual void DirectRead(tInputStream& input_stream, tFixedBuffer& buffer, size_t offset, size_t len) override
+  {
+    assert(false && "Not supported");
+  }
+  virtual bool DirectReadSupport() const override
+  {
+    return false;
+  }
+  virtual bool MoreDataAvailable(tInputStream& input_stream, tBufferInfo& buffer) override
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return !pending.empty();
+  }
+  virtual void Read(tInputStream& input_stream, tBufferInfo& buffer, size_t len) override
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    data_available.wait(lock, [&]() { return pending.size() >= len; });
+    current.swap(pending);
+    pending.clear();
+    backend = tFixedBuffer(current.data(), current.size());
+    buffer.buffer = &backend;
+    buffer.position = 0;
+    buffer.SetRange(0, current.size());
+  }
+  virtual void Reset(tInputStream& input_stream, tBufferInfo& buffer) override
+  {
+    buffer.buffer = &backend;
+    buffer.position = 0;
+    buffer.SetRange(0, 0);
+  }
+  virtual void Seek(tInputStream& input_stream, tBufferInfo& buffer, uint64_t position) override
+  {
+    throw std::runtime_error("Not supported");
+  }
+  virtual bool SeekSupport() override
+  {
+    return false;
+  }
+  virtual bool WaitForData(tInputStream& input_stream, tBufferInfo& buffer, const rrlib::time::tDuration& timeout) override
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    wait_calls++;
+    return data_available.wait_for(lock, timeout, [&]() { return !pending.empty(); });
+  }
+  virtual bool WaitForDataSupport() override
+  {
+    return true;
+  }
+};
+
 class TestSerialization : public util::tUnitTestSuite
 {
   RRLIB_UNIT_TESTS_BEGIN_SUITE(TestSerialization);
@@ -90,6 +181,27 @@ class TestSerialization : public util::tUnitTestSuite
   RRLIB_UNIT_TESTS_ADD_TEST(TestBinarySet);
   RRLIB_UNIT_TESTS_ADD_TEST(TestEnumsBinary);
   RRLIB_UNIT_TESTS_ADD_TEST(TestEnumsString);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestSparseEnums);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestBulkContainers);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestPackedBoolVectors);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestVariableLengthIntegers);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestReservedWriter);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestFixedSizeValues);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestSerializedSize);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestNestedSkipOffsets);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestStaticOutputStream);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestMarkRollback);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestDirectWriteThreshold);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestViews);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestBulkNumbers);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestWaitForData);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestResumableDeserialization);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestAsyncInputStream);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestLazy);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestIndexedContainer);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestLengthPrefixedStrings);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestChunkedMemoryBuffer);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestMemoryBufferPool);
   RRLIB_UNIT_TESTS_END_SUITE;
 
 
@@ -184,6 +296,31 @@ private:
     RRLIB_UNIT_TESTS_ASSERT(max_unsigned == tEnumUnsigned::MAX_VALUE);
   }
 
+  void TestSparseEnums()
+  {
+    if (!make_builder::internal::GetEnumStrings<tSparseEnum>().non_standard_values)
+    {
+      RRLIB_LOG_PRINT(WARNING, "No enum values are available. They are only available when using the clang plugin for generating enum strings - instead of doxygen (which is deprecated). Skipping test.");
+      return;
+    }
+
+    tMemoryBuffer mb;
+    tOutputStream os(mb);
+    os << tSparseEnum::FOURTH << tSparseEnum::SECOND << tSparseEnum::FIRST << tSparseEnum::THIRD;
+    RRLIB_UNIT_TESTS_EXCEPTION_MESSAGE("Value that is no enum constant must be rejected", os << static_cast<tSparseEnum>(8), std::runtime_error);
+    os.Close();
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(4), mb.GetSize());
+    RRLIB_UNIT_TESTS_EQUALITY(3, static_cast<int>(mb.GetBufferPointer()[0]));  // index of enum constant
+
+    tInputStream is(mb);
+    tSparseEnum e1, e2, e3, e4;
+    is >> e1 >> e2 >> e3 >> e4;
+    RRLIB_UNIT_TESTS_ASSERT(e1 == tSparseEnum::FOURTH && e2 == tSparseEnum::SECOND && e3 == tSparseEnum::FIRST && e4 == tSparseEnum::THIRD);
+
+    RRLIB_UNIT_TESTS_ASSERT(tSparseEnum::SECOND == Deserialize<tSparseEnum>("(-5)"));
+    RRLIB_UNIT_TESTS_EXCEPTION_MESSAGE("Number that is no enum constant must be rejected", Deserialize<tSparseEnum>("(43)"), std::runtime_error);
+  }
+
   void TestEnumsString()
   {
     if (!make_builder::internal::GetEnumStrings<tEnumSigned>().non_standard_values)
@@ -217,6 +354,1010 @@ private:
     RRLIB_UNIT_TESTS_ASSERT(all == Deserialize<tFlags>(Serialize(all)));
   }
 
+  void TestBulkContainers()
+  {
+    std::vector<float> floats;
+    std::vector<int16_t> shorts;
+    for (size_t i = 0; i < 100000; i++)
+    {
+      floats.push_back(i * 0.5f);
+      shorts.push_back(static_cast<int16_t>(i * 7));
+    }
+    std::array<uint32_t, 5> array = {{ 1, 2, 3, 0xFFFFFFFF, 5 }};
+    TestBinarySerialization(floats);
+    TestBinarySerialization(shorts);
+    TestBinarySerialization(array);
+    TestBinarySerialization(std::vector<double>());
+
+    // Binary format must not change
+    rrlib::serialization::tMemoryBuffer mb;
+    rrlib::serialization::tOutputStream os(mb);
+    os << shorts << array;
+    os.Close();
+    rrlib::serialization::tInputStream is(mb);
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<int>(shorts.size()), is.ReadInt());
+    RRLIB_UNIT_TESTS_EQUALITY(true, is.ReadBoolean());
+    for (int16_t value : shorts)
+    {
+      RRLIB_UNIT_TESTS_EQUALITY(value, is.ReadShort());
+    }
+    for (uint32_t value : array)
+    {
+      RRLIB_UNIT_TESTS_EQUALITY(value, is.ReadNumber<uint32_t>());
+    }
+    RRLIB_UNIT_TESTS_ASSERT(!is.MoreDataAvailable());
+  }
+
+  void TestPackedBoolVectors()
+  {
+    for (size_t size : { 0, 1, 8, 63, 64, 65, 1000 })
+    {
+      std::vector<bool> bools;
+      for (size_t i = 0; i < size; i++)
+      {
+        bools.push_back((i % 3) == 0 || (i % 7) == 0);
+      }
+
+      rrlib::serialization::tMemoryBuffer mb;
+      rrlib::serialization::tOutputStream os(mb);
+      os.SetPackedBoolVectors(true);
+      os << bools;
+      os.Close();
+      RRLIB_UNIT_TESTS_EQUALITY(5 + (size + 7) / 8, mb.GetSize());
+
+      rrlib::serialization::tInputStream is(mb);
+      is.SetPackedBoolVectors(true);
+      std::vector<bool> result;
+      is >> result;
+      RRLIB_UNIT_TESTS_ASSERT(bools == result);
+    }
+  }
+
+  void TestVariableLengthIntegers()
+  {
+    const int64_t cSIGNED_VALUES[] = { 0, 1, -1, 63, -64, 64, -65, 1000000, std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max() };
+    const uint64_t cUNSIGNED_VALUES[] = { 0, 1, 127, 128, 16383, 16384, std::numeric_limits<uint64_t>::max() };
+    std::vector<std::string> strings = { "a", "b", "c" };
+
+    rrlib::serialization::tMemoryBuffer mb;
+    rrlib::serialization::tOutputStream os(mb, tTypeEncoding::LOCAL_UIDS, tIntegerEncoding::VARIABLE);
+    for (int64_t value : cSIGNED_VALUES)
+    {
+      os.WriteEncodedNumber(value);
+    }
+    for (uint64_t value : cUNSIGNED_VALUES)
+    {
+      os.WriteEncodedNumber(value);
+    }
+    os.WriteEncodedNumber<int16_t>(-300);
+    os.WriteEncodedNumber<uint64_t>(300);
+    size_t size_before_container = os.GetPosition();
+    os << strings;
+    os.Close();
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(1 + 1 + 3 * 2), mb.GetSize() - size_before_container);
+
+    rrlib::serialization::tInputStream is(mb, tTypeEncoding::LOCAL_UIDS, tIntegerEncoding::VARIABLE);
+    for (int64_t value : cSIGNED_VALUES)
+    {
+      RRLIB_UNIT_TESTS_EQUALITY(value, is.ReadEncodedNumber<int64_t>());
+    }
+    for (uint64_t value : cUNSIGNED_VALUES)
+    {
+      RRLIB_UNIT_TESTS_EQUALITY(value, is.ReadEncodedNumber<uint64_t>());
+    }
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<int16_t>(-300), is.ReadEncodedNumber<int16_t>());
+    RRLIB_UNIT_TESTS_EXCEPTION_MESSAGE("Value must not fit into uint8_t", is.ReadEncodedNumber<uint8_t>(), std::runtime_error);
+    std::vector<std::string> other_strings;
+    is >> other_strings;
+    RRLIB_UNIT_TESTS_ASSERT(strings == other_strings);
+
+    // invalid varints
+    tMemoryBuffer invalid_buffer;
+    tOutputStream invalid_os(invalid_buffer);
+    invalid_os.WriteVarint(0xFFFFFFFFFFFFFFFFull);  // largest valid varint (10 bytes)
+    for (int i = 0; i < 9; i++)
+    {
+      invalid_os.WriteByte(0xFF);
+    }
+    invalid_os.WriteByte(0x02);  // 10th byte exceeds 64 bits
+    for (int i = 0; i < 11; i++)
+    {
+      invalid_os.WriteByte(0x80);  // longer than 10 bytes
+    }
+    invalid_os.WriteByte(0);
+    invalid_os.Close();
+    tInputStream invalid_is(invalid_buffer);
+    RRLIB_UNIT_TESTS_EQUALITY(0xFFFFFFFFFFFFFFFFull, static_cast<unsigned long long>(invalid_is.ReadVarint()));
+    RRLIB_UNIT_TESTS_EXCEPTION_MESSAGE("Varint must not exceed 64 bits", invalid_is.ReadVarint(), std::runtime_error);
+    RRLIB_UNIT_TESTS_EXCEPTION_MESSAGE("Varint must not be longer than 10 bytes", invalid_is.ReadVarint(), std::runtime_error);
+  }
+
+  void TestReservedWriter()
+  {
+    tStackMemoryBuffer<32> buffer1, buffer2;  // small buffers so that reallocation is required
+    tOutputStream os1(buffer1), os2(buffer2);
+    for (int i = 0; i < 10; i++)
+    {
+      os1 << i << static_cast<int16_t>(i) << (i * 0.5) << (i * 0.25f) << true << static_cast<int64_t>(-i);
+      {
+        auto writer = os2.Reserve(100);
+        writer.WriteInt(i);
+        writer.WriteShort(i);
+        writer.WriteDouble(i * 0.5);
+        writer.WriteFloat(i * 0.25f);
+        writer.WriteBoolean(true);
+        writer.WriteLong(-i);
+      }
+    }
+    os1.Close();
+    os2.Close();
+    RRLIB_UNIT_TESTS_ASSERT(buffer1 == buffer2);
+  }
+
+  void TestFixedSizeValues()
+  {
+    typedef std::tuple<int16_t, float, std::array<int, 3>> tTuple;
+    std::vector<std::pair<uint8_t, int>> pairs;
+    std::vector<tTuple> tuples;
+    for (int i = 0; i < 50; i++)
+    {
+      pairs.emplace_back(i, -i);
+      tuples.emplace_back(i, i * 0.5f, std::array<int, 3> {{ i, i + 1, i + 2 }});
+    }
+
+    tStackMemoryBuffer<32> buffer;  // small buffer so that reallocation is required
+    tOutputStream os(buffer);
+    os << pairs << tuples << pairs[3] << tuples[7];
+    os.Close();
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(5 + 50 * 5 + 5 + 50 * 18 + 5 + 18), buffer.GetSize());
+
+    tInputStream is(buffer);
+    std::vector<std::pair<uint8_t, int>> pairs2;
+    std::vector<tTuple> tuples2;
+    std::pair<uint8_t, int> pair;
+    tTuple tuple;
+    is >> pairs2 >> tuples2 >> pair >> tuple;
+    RRLIB_UNIT_TESTS_ASSERT(pairs == pairs2);
+    RRLIB_UNIT_TESTS_ASSERT(tuples == tuples2);
+    RRLIB_UNIT_TESTS_ASSERT(pair == pairs[3]);
+    RRLIB_UNIT_TESTS_ASSERT(tuple == tuples[7]);
+
+    // objects without fixed size are deserialized in order to skip them
+    tMemoryBuffer buffer2;
+    tOutputStream os2(buffer2);
+    os2 << std::string("skipped") << std::string() << 42;
+    os2.Close();
+    tInputStream is2(buffer2);
+    is2.SkipValues<std::string>(2);
+    RRLIB_UNIT_TESTS_EQUALITY(42, is2.ReadInt());
+  }
+
+  void TestSerializedSize()
+  {
+    std::map<std::string, std::vector<int>> map;
+    for (int i = 0; i < 200; i++)
+    {
+      map[std::to_string(i)] = std::vector<int>(i * 10, i);
+    }
+    std::vector<bool> bools(1000, true);
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(12), GetSerializedSize(std::make_pair(1.0, 2)));
+
+    for (tIntegerEncoding encoding : { tIntegerEncoding::FIXED, tIntegerEncoding::VARIABLE })
+    {
+      for (bool compact : { false, true })
+      {
+        tOutputStream settings(tTypeEncoding::LOCAL_UIDS, encoding);
+        settings.SetPackedBoolVectors(compact);
+        settings.SetStringEncoding(compact ? tStringEncoding::LENGTH_PREFIXED : tStringEncoding::NULL_TERMINATED);
+        size_t size = GetSerializedSize(map, settings) + GetSerializedSize(bools, settings);
+        tMemoryBuffer buffer(16);
+        buffer.Reserve(size);
+        auto capacity = buffer.GetCapacity();
+        tOutputStream os(buffer);
+        os.CopyEncodingSettings(settings);
+        os << map << bools;
+        os.Close();
+        RRLIB_UNIT_TESTS_EQUALITY(size, buffer.GetSize());
+        RRLIB_UNIT_TESTS_EQUALITY(capacity, buffer.GetCapacity());
+      }
+    }
+
+    // skip offsets
+    tCountingSink sink(16);
+    tOutputStream os(sink);
+    os.WriteSkipOffsetPlaceholder();
+    os << map;
+    os.SkipTargetHere();
+    os.WriteInt(0);
+    os.Close();
+    RRLIB_UNIT_TESTS_EQUALITY(GetSerializedSize(map) + 8, sink.GetSize());
+
+    // short skip offsets spanning buffer flushes
+    tCountingSink sink2(16);
+    tOutputStream os2(sink2);
+    std::string string(100, 'x');
+    for (int i = 0; i < 10000; i++)
+    {
+      os2.WriteSkipOffsetPlaceholder(true);
+      os2 << string;
+      RRLIB_UNIT_TESTS_EQUALITY(string.size() + 1, os2.GetSkipOffset());
+      os2.SkipTargetHere();
+    }
+    os2.Close();
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(10000 * 102), sink2.GetSize());
+  }
+
+  void TestNestedSkipOffsets()
+  {
+    tMemoryBuffer buffer;
+    tOutputStream os(buffer);
+    for (int i = 0; i < 3; i++)
+    {
+      os.WriteSkipOffsetPlaceholder();
+      os.WriteInt(i);
+      os.WriteSkipOffsetPlaceholder(true);
+      os << std::vector<int>(20, i);
+      os.SkipTargetHere();
+      os.WriteSkipOffsetPlaceholder();
+      os << std::string(i * 100, 'x');
+      os.SkipTargetHere();
+      os.WriteInt(-i);
+      os.SkipTargetHere();
+    }
+    os.WriteInt(42);
+
+    // empty inner blocks
+    os.WriteSkipOffsetPlaceholder();
+    os.WriteInt(7);
+    os.WriteSkipOffsetPlaceholder();
+    os.SkipTargetHere();
+    os.SkipTargetHere();
+    os.WriteSkipOffsetPlaceholder();
+    os.WriteSkipOffsetPlaceholder();
+    os.SkipTargetHere();
+    os.WriteInt(8);
+    os.SkipTargetHere();
+    os.WriteInt(43);
+    os.Close();
+
+    tInputStream is(buffer);
+
+    // skip outer block
+    is.ReadSkipOffset();
+    is.ToSkipTarget();
+
+    // skip inner blocks
+    is.ReadSkipOffset();
+    RRLIB_UNIT_TESTS_EQUALITY(1, is.ReadInt());
+    is.ReadSkipOffset(true);
+    is.ToSkipTarget();
+    is.ReadSkipOffset();
+    is.ToSkipTarget();
+    RRLIB_UNIT_TESTS_EQUALITY(-1, is.ReadInt());
+    is.ToSkipTarget();
+
+    // read first inner block completely (without moving to its target explicitly) - then skip rest of outer block
+    is.ReadSkipOffset();
+    RRLIB_UNIT_TESTS_EQUALITY(2, is.ReadInt());
+    is.ReadSkipOffset(true);
+    std::vector<int> vector;
+    is >> vector;
+    RRLIB_UNIT_TESTS_EQUALITY(std::vector<int>(20, 2), vector);
+    is.ReadSkipOffset();
+    is.ToSkipTarget();
+    is.ToSkipTarget();
+
+    RRLIB_UNIT_TESTS_EQUALITY(42, is.ReadInt());
+
+    // inner block ending where outer block ends: ToSkipTarget() must be called for inner block first
+    is.ReadSkipOffset();
+    RRLIB_UNIT_TESTS_EQUALITY(7, is.ReadInt());
+    is.ReadSkipOffset();
+    is.ToSkipTarget();
+    is.ToSkipTarget();
+
+    // empty inner block is discarded, when stream moves beyond it
+    is.ReadSkipOffset();
+    is.ReadSkipOffset();
+    RRLIB_UNIT_TESTS_EQUALITY(8, is.ReadInt());
+    is.ToSkipTarget();
+    RRLIB_UNIT_TESTS_EQUALITY(43, is.ReadInt());
+  }
+
+  void TestStaticOutputStream()
+  {
+    std::map<std::string, std::vector<int>> map;
+    for (int i = 0; i < 50; i++)
+    {
+      map[std::to_string(i)] = std::vector<int>(i, i);
+    }
+
+    tMemoryBuffer buffer1(16), buffer2(16);
+    tStaticOutputStream<tMemoryBuffer> os1(buffer1);
+    tOutputStream os2(buffer2);
+    for (int i = 0; i < 3; i++)
+    {
+      os1.Reset(buffer1);
+      os2.Reset(buffer2);
+      os1 << map << i;
+      os2 << map << i;
+      os1.Flush();
+      os2.Flush();
+      RRLIB_UNIT_TESTS_ASSERT(buffer1 == buffer2);
+      map.erase(map.begin());
+    }
+    os1.Close();
+
+    tInputStream is(buffer1);
+    std::map<std::string, std::vector<int>> map2;
+    is >> map2;
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(48), map2.size());
+    RRLIB_UNIT_TESTS_EQUALITY(2, is.ReadInt());
+  }
+
+  void TestMarkRollback()
+  {
+    tStackMemoryBuffer<32> buffer;  // small buffer so that reallocation is required
+    tOutputStream os(buffer);
+    os.WriteInt(1);
+    auto mark = os.Mark();
+    os << std::string(100, 'x');
+    os.Rollback(mark);
+    os.WriteInt(2);
+
+    // nested marks
+    auto outer = os.Mark();
+    os.WriteInt(3);
+    auto inner = os.Mark();
+    os.WriteSkipOffsetPlaceholder();
+    os << std::vector<int>(50, 4);
+    os.Rollback(inner);
+    os.WriteInt(5);
+    os.Commit(outer);
+    os.Flush();
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(16), buffer.GetSize());
+
+    // uncommitted data is not visible in buffer - and discarded on close
+    os.Mark();
+    os.WriteInt(6);
+    os.Flush();
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(16), buffer.GetSize());
+    os.Close();
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(16), buffer.GetSize());
+
+    tInputStream is(buffer);
+    for (int i : { 1, 2, 3, 5 })
+    {
+      RRLIB_UNIT_TESTS_EQUALITY(i, is.ReadInt());
+    }
+
+    // marked data is kept when buffer is reallocated
+    tMemoryBuffer growing_buffer(16);
+    tOutputStream os2(growing_buffer);
+    os2.WriteInt(-1);
+    auto growing_mark = os2.Mark();
+    for (int i = 0; i < 1000; i++)
+    {
+      os2.WriteInt(i);
+    }
+    os2.Commit(growing_mark);
+    os2.Close();
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(4004), growing_buffer.GetSize());
+    tInputStream is2(growing_buffer);
+    RRLIB_UNIT_TESTS_EQUALITY(-1, is2.ReadInt());
+    for (int i = 0; i < 1000; i++)
+    {
+      RRLIB_UNIT_TESTS_EQUALITY(i, is2.ReadInt());
+    }
+  }
+
+  void TestDirectWriteThreshold()
+  {
+    tCountingSink sink(4096);
+    tOutputStream os(sink);
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(1024), os.GetDirectWriteThreshold());
+
+    // repeated medium-sized blocks raise threshold (up to half the buffer capacity)
+    tFixedBuffer block(1500);
+    for (int i = 0; i < 50; i++)
+    {
+      os.Write(block);
+    }
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(2048), os.GetDirectWriteThreshold());
+
+    // small blocks do not lower threshold
+    tFixedBuffer small_block(10);
+    for (int i = 0; i < 200; i++)
+    {
+      os.Write(small_block);
+    }
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(2048), os.GetDirectWriteThreshold());
+
+    os.SetDirectWriteThreshold(100);
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(100), os.GetDirectWriteThreshold());
+    os.Write(block);
+    os.SetDirectWriteThreshold(0);
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(2048), os.GetDirectWriteThreshold());
+    os.Close();
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(51 * 1500 + 200 * 10), sink.GetSize());
+  }
+
+  void TestViews()
+  {
+    tMemoryBuffer buffer;
+    tOutputStream os(buffer);
+    os << std::string("topic/a") << std::string() << 42;
+    os.Close();
+
+    // data in memory buffer is not copied
+    tInputStream is(buffer);
+    tDataView topic = is.ReadStringView();
+    RRLIB_UNIT_TESTS_ASSERT(topic == "topic/a" && topic != std::string("topic/b"));
+    RRLIB_UNIT_TESTS_ASSERT(topic.Data() == buffer.GetBufferPointer());
+    RRLIB_UNIT_TESTS_ASSERT(is.ReadStringView().Empty());
+    tDataView bytes = is.ReadBytesView(4);
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(4), bytes.Size());
+    RRLIB_UNIT_TESTS_ASSERT(bytes.Data() == buffer.GetBufferPointer(9));
+    RRLIB_UNIT_TESTS_ASSERT(!is.MoreDataAvailable());
+  }
+
+  void TestBulkNumbers()
+  {
+    std::vector<int32_t> ints;
+    std::vector<uint16_t> shorts;
+    std::vector<double> doubles;
+    for (int i = 0; i < 5000; i++)
+    {
+      ints.push_back(i * 1000 - 20000);
+      shorts.push_back(i * 13);
+      doubles.push_back(i * 0.5);
+    }
+
+    tMemoryBuffer buffer(16);
+    tOutputStream os(buffer);
+    os.WriteNumbers(ints.data(), ints.size());
+    os.WriteNumbers(shorts.data(), shorts.size());
+    os.WriteNumbers(doubles.data(), doubles.size());
+    os.Close();
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(5000 * 14), buffer.GetSize());
+    RRLIB_UNIT_TESTS_ASSERT(buffer.GetBufferPointer()[4] == static_cast<char>(0xC8) && buffer.GetBufferPointer()[5] == static_cast<char>(0xB5));  // -19000 in little endian
+
+    tInputStream is(buffer);
+    std::vector<int32_t> ints_read(ints.size());
+    std::vector<uint16_t> shorts_read(shorts.size());
+    std::vector<double> doubles_read(doubles.size());
+    is.ReadNumbers(ints_read.data(), ints_read.size());
+    is.ReadNumbers(shorts_read.data(), shorts_read.size());
+    is.ReadNumbers(doubles_read.data(), doubles_read.size());
+    RRLIB_UNIT_TESTS_ASSERT(ints == ints_read && shorts == shorts_read && doubles == doubles_read);
+
+    // byte order swapping (used on big endian platforms)
+    uint32_t values[3] = { 0x01020304, 0xA0B0C0D0, 0 };
+    char swapped[12];
+    detail::SwapByteOrder<uint32_t>(values, swapped + 1, 2);
+    RRLIB_UNIT_TESTS_ASSERT(swapped[1] == 0x01 && swapped[4] == 0x04 && swapped[5] == static_cast<char>(0xA0));
+    detail::SwapByteOrder<uint32_t>(values, values, 2);
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<uint32_t>(0x04030201), values[0]);
+  }
+
+  void TestWaitForData()
+  {
+    tQueueSource source;
+    tInputStream is(source);
+    is.SetTimeout(std::chrono::seconds(10));
+    int32_t value = 42;
+    std::thread writer([&]()
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+      source.Push(&value, sizeof(value));
+    });
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    RRLIB_UNIT_TESTS_EQUALITY(42, is.ReadInt());
+    writer.join();
+    RRLIB_UNIT_TESTS_ASSERT(source.wait_calls > 0);
+    RRLIB_UNIT_TESTS_ASSERT(std::chrono::steady_clock::now() - start < std::chrono::seconds(5));
+
+    is.SetTimeout(std::chrono::milliseconds(20));
+    RRLIB_UNIT_TESTS_EXCEPTION_MESSAGE("Read must time out", is.ReadInt(), std::runtime_error);
+  }
+
+  void TestResumableDeserialization()
+  {
+    typedef std::pair<int, std::vector<std::string>> tMessage;
+    std::vector<tMessage> messages;
+    tMemoryBuffer serialized;
+    tOutputStream os(serialized);
+    for (int i = 0; i < 200; i++)
+    {
+      messages.emplace_back(i, std::vector<std::string>(i % 5, std::string(i, 'x')));
+      os.WriteSkipOffsetPlaceholder();
+      os << messages.back();
+      os.SkipTargetHere();
+    }
+    os.Close();
+
+    // data arrives in small pieces
+    tReceiveBuffer receive_buffer(64);
+    tInputStream is(receive_buffer);
+    std::vector<tMessage> received;
+    size_t max_size = 0;
+    for (size_t offset = 0; offset < serialized.GetSize(); offset += 7)
+    {
+      receive_buffer.Append(serialized.GetBufferPointer(offset), std::min<size_t>(7, serialized.GetSize() - offset));
+      max_size = std::max(max_size, receive_buffer.GetSize());
+      while (is.MoreDataAvailable())
+      {
+        tInputStream::tCheckpoint checkpoint = is.Checkpoint();
+        tMessage message;
+        try
+        {
+          is.ReadSkipOffset();
+          is >> message;
+          is.ToSkipTarget();
+        }
+        catch (const tNeedMoreDataException&)
+        {
+          is.RestoreCheckpoint(checkpoint);
+          RRLIB_UNIT_TESTS_EQUALITY(checkpoint.GetPosition(), is.GetAbsoluteReadPosition());
+          break;
+        }
+        receive_buffer.Discard(is.GetAbsoluteReadPosition());
+        received.push_back(message);
+      }
+    }
+    RRLIB_UNIT_TESTS_ASSERT(messages == received);
+    RRLIB_UNIT_TESTS_ASSERT(max_size < serialized.GetSize() / 4);
+  }
+
+  void TestAsyncInputStream()
+  {
+    // several connections are served by one loop - data arrives in pieces of different size
+    enum { cCONNECTIONS = 10, cMESSAGES = 50 };
+    std::vector<tMemoryBuffer> serialized(cCONNECTIONS);
+    std::vector<std::unique_ptr<tAsyncInputStream>> streams;
+    for (int i = 0; i < cCONNECTIONS; i++)
+    {
+      tOutputStream os(serialized[i]);
+      for (int j = 0; j < cMESSAGES; j++)
+      {
+        os << std::string(j * i, 'x') << std::map<int, double>({ { i, j * 0.5 }, { j, i * 0.5 } });
+      }
+      os.Close();
+      streams.emplace_back(new tAsyncInputStream());
+    }
+
+    std::vector<size_t> offsets(cCONNECTIONS, 0);
+    std::vector<int> received(cCONNECTIONS, 0);
+    bool data_left = true;
+    while (data_left)
+    {
+      data_left = false;
+      for (int i = 0; i < cCONNECTIONS; i++)
+      {
+        size_t size = std::min<size_t>(i + 1, serialized[i].GetSize() - offsets[i]);
+        streams[i]->Append(serialized[i].GetBufferPointer(offsets[i]), size);
+        offsets[i] += size;
+        data_left |= offsets[i] < serialized[i].GetSize();
+
+        std::string text;
+        std::map<int, double> values;
+        auto read_message = [&](tInputStream & stream)
+        {
+          stream >> text >> values;
+        };
+        while (streams[i]->TryReadUsing(read_message))
+        {
+          int j = received[i];
+          std::map<int, double> expected_values = { { i, j * 0.5 }, { j, i * 0.5 } };
+          RRLIB_UNIT_TESTS_ASSERT(text == std::string(j * i, 'x') && values == expected_values);
+          received[i]++;
+        }
+      }
+    }
+    RRLIB_UNIT_TESTS_ASSERT(received == std::vector<int>(cCONNECTIONS, cMESSAGES));
+
+    tMemoryBuffer int_buffer;
+    tOutputStream int_stream(int_buffer);
+    int_stream.WriteInt(42);
+    int_stream.Close();
+    int value = 0;
+    RRLIB_UNIT_TESTS_ASSERT(!streams[0]->TryRead(value));
+    streams[0]->Append(int_buffer.GetBufferPointer(), 2);
+    RRLIB_UNIT_TESTS_ASSERT(!streams[0]->TryRead(value));
+    streams[0]->Append(int_buffer.GetBufferPointer(2), 2);
+    RRLIB_UNIT_TESTS_ASSERT(streams[0]->TryRead(value));
+    RRLIB_UNIT_TESTS_EQUALITY(42, value);
+
+    // object with skip offset arriving byte by byte is only read again once it is complete
+    tMemoryBuffer framed_buffer;
+    tOutputStream framed_stream(framed_buffer);
+    framed_stream.WriteSkipOffsetPlaceholder();
+    framed_stream << std::string(1000, 'x');
+    framed_stream.SkipTargetHere();
+    framed_stream.Close();
+    tAsyncInputStream framed_input;
+    std::string text;
+    int attempts = 0;
+    auto read_framed = [&](tInputStream & stream)
+    {
+      attempts++;
+      stream.ReadSkipOffset();
+      stream >> text;
+      stream.ToSkipTarget();
+    };
+    for (size_t i = 0; i < framed_buffer.GetSize(); i++)
+    {
+      framed_input.Append(framed_buffer.GetBufferPointer(i), 1);
+      RRLIB_UNIT_TESTS_EQUALITY(i + 1 == framed_buffer.GetSize(), framed_input.TryReadUsing(read_framed));
+    }
+    RRLIB_UNIT_TESTS_ASSERT(text == std::string(1000, 'x'));
+    RRLIB_UNIT_TESTS_EQUALITY(3, attempts);
+  }
+
+  void TestLazy()
+  {
+    typedef std::map<std::string, std::vector<int>> tPayload;
+    std::vector<tLazy<tPayload>> fields(20);
+    for (int i = 0; i < 20; i++)
+    {
+      tPayload payload;
+      payload[std::to_string(i)] = std::vector<int>(i * 100, i);
+      fields[i].Set(payload);
+    }
+
+    tMemoryBuffer buffer;
+    tOutputStream os(buffer, tTypeEncoding::LOCAL_UIDS, tIntegerEncoding::VARIABLE);
+    os << fields;
+    os.Close();
+
+    // only accessed fields are decoded
+    std::vector<tLazy<tPayload>> read_fields;
+    tInputStream is(buffer, tTypeEncoding::LOCAL_UIDS, tIntegerEncoding::VARIABLE);
+    is >> read_fields;
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(20), read_fields.size());
+    RRLIB_UNIT_TESTS_ASSERT(!read_fields[7].IsDecoded());
+    const tLazy<tPayload>& field = read_fields[7];
+    RRLIB_UNIT_TESTS_ASSERT(field.Get() == fields[7].Get());
+    RRLIB_UNIT_TESTS_ASSERT(read_fields[7].IsDecoded() && !read_fields[8].IsDecoded());
+
+    // unmodified fields are serialized as they are
+    tMemoryBuffer buffer2;
+    tOutputStream os2(buffer2, tTypeEncoding::LOCAL_UIDS, tIntegerEncoding::VARIABLE);
+    os2 << read_fields;
+    os2.Close();
+    RRLIB_UNIT_TESTS_ASSERT(buffer == buffer2);
+
+    // lazy values can be skipped
+    tMemoryBuffer buffer3;
+    tOutputStream os3(buffer3);
+    os3 << fields[0] << fields[1];
+    os3.Close();
+    tInputStream is3(buffer3);
+    is3.ReadSkipOffset();
+    is3.ToSkipTarget();
+    tLazy<tPayload> second;
+    is3 >> second;
+    RRLIB_UNIT_TESTS_ASSERT(second.Get() == fields[1].Get());
+  }
+
+  void TestIndexedContainer()
+  {
+    std::vector<std::string> strings;
+    for (int i = 0; i < 1000; i++)
+    {
+      strings.push_back(std::string(i % 37, 'a' + (i % 26)) + std::to_string(i));
+    }
+
+    tMemoryBuffer buffer;
+    tOutputStream os(buffer);
+    WriteIndexedContainer(os, strings);
+    os << std::string("after");
+    os.Close();
+
+    // random access
+    tInputStream is(buffer);
+    tIndexedContainerReader reader(is);
+    RRLIB_UNIT_TESTS_EQUALITY(strings.size(), reader.Size());
+    std::string element;
+    for (size_t index : std::vector<size_t> { 999, 0, 500, 1, 998, 500 })
+    {
+      reader.Read(index, element);
+      RRLIB_UNIT_TESTS_EQUALITY(strings[index], element);
+    }
+    is.Seek(reader.GetEndPosition());
+    RRLIB_UNIT_TESTS_EQUALITY(std::string("after"), is.ReadString());
+
+    // sequential access
+    tInputStream is2(buffer);
+    std::vector<std::string> read_strings;
+    ReadIndexedContainer(is2, read_strings);
+    RRLIB_UNIT_TESTS_ASSERT(strings == read_strings);
+    RRLIB_UNIT_TESTS_EQUALITY(std::string("after"), is2.ReadString());
+
+    // corrupt containers: container size that exceeds offset table - and offsets beyond offset table
+    tMemoryBuffer corrupt_size;
+    tOutputStream os2(corrupt_size);
+    os2.WriteEncodedNumber<uint32_t>(0xFFFFFFF0);
+    os2.WriteInt(0);
+    os2.WriteInt(0);
+    os2.Close();
+    tInputStream is3(corrupt_size);
+    RRLIB_UNIT_TESTS_EXCEPTION_MESSAGE("Missing offsets must be detected", tIndexedContainerReader corrupt_reader(is3), std::out_of_range);
+    tMemoryBuffer corrupt_offsets;
+    tOutputStream os3(corrupt_offsets);
+    os3.WriteEncodedNumber<uint32_t>(2);
+    os3.WriteInt(4);
+    os3.WriteInt(0);
+    os3.WriteInt(0);
+    os3.WriteInt(8);
+    os3.Close();
+    tInputStream is4(corrupt_offsets);
+    RRLIB_UNIT_TESTS_EXCEPTION_MESSAGE("Offsets beyond offset table must be rejected", tIndexedContainerReader corrupt_reader(is4), std::runtime_error);
+  }
+
+  void TestLengthPrefixedStrings()
+  {
+    const std::string with_null("abc\0def", 7);
+    const std::string long_string(5000, 'y');
+    for (tIntegerEncoding integer_encoding : { tIntegerEncoding::FIXED, tIntegerEncoding::VARIABLE })
+    {
+      tMemoryBuffer buffer;
+      tOutputStream os(buffer, tTypeEncoding::LOCAL_UIDS, integer_encoding);
+      os.SetStringEncoding(tStringEncoding::LENGTH_PREFIXED);
+      for (int i = 0; i < 3; i++)
+      {
+        os << with_null << long_string << "const char" << std::string() << i;
+      }
+      os.Close();
+      size_t prefix_bytes = integer_encoding == tIntegerEncoding::FIXED ? 16 : 5;  // the length 5000 needs two bytes as varint
+      RRLIB_UNIT_TESTS_EQUALITY(3 * (7 + 5000 + 10 + prefix_bytes + 4), buffer.GetSize());
+
+      tInputStream is(buffer, tTypeEncoding::LOCAL_UIDS, integer_encoding);
+      is.SetStringEncoding(tStringEncoding::LENGTH_PREFIXED);
+
+      // complete strings
+      std::string string_buffer;
+      is >> string_buffer;
+      RRLIB_UNIT_TESTS_EQUALITY(with_null, string_buffer);
+      RRLIB_UNIT_TESTS_EQUALITY(long_string, is.ReadString());
+      RRLIB_UNIT_TESTS_ASSERT(is.ReadStringView() == "const char");
+      std::stringstream string_stream;
+      is.ReadString(string_stream);
+      RRLIB_UNIT_TESTS_EQUALITY(std::string(), string_stream.str());
+      RRLIB_UNIT_TESTS_EQUALITY(0, is.ReadInt());
+
+      // strings exceeding maximum length are consumed completely
+      RRLIB_UNIT_TESTS_EQUALITY(std::string("abc"), is.ReadString(3));
+      char char_buffer[11];
+      RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(11), is.ReadString(char_buffer, true));
+      RRLIB_UNIT_TESTS_EQUALITY(std::string(10, 'y'), std::string(char_buffer));
+      RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(11), is.ReadString(char_buffer, true));
+      RRLIB_UNIT_TESTS_EQUALITY(std::string("const char"), std::string(char_buffer));
+      RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(1), is.ReadString(char_buffer, false));
+      RRLIB_UNIT_TESTS_EQUALITY(1, is.ReadInt());
+
+      // skipping
+      for (int i = 0; i < 4; i++)
+      {
+        is.SkipString();
+      }
+      RRLIB_UNIT_TESTS_EQUALITY(2, is.ReadInt());
+      RRLIB_UNIT_TESTS_ASSERT(!is.MoreDataAvailable());
+    }
+  }
+
+  void TestChunkedMemoryBuffer()
+  {
+    std::vector<int> numbers(1000);
+    for (size_t i = 0; i < numbers.size(); i++)
+    {
+      numbers[i] = i * 7;
+    }
+    std::vector<std::string> strings;
+    for (int i = 0; i < 200; i++)
+    {
+      strings.push_back(std::string(i, 'a' + (i % 26)));
+    }
+
+    // write the same data to chunked and contiguous memory buffer
+    tChunkedMemoryBuffer chunked_buffer(256);
+    tMemoryBuffer memory_buffer;
+    for (int pass = 0; pass < 2; pass++)  // second pass reuses chunks
+    {
+      for (int i = 0; i < 2; i++)
+      {
+        tOutputStream os;
+        if (i == 0)
+        {
+          os.Reset(chunked_buffer);
+        }
+        else
+        {
+          os.Reset(memory_buffer);
+        }
+        os << numbers << strings;
+        WriteIndexedContainer(os, strings);  // skip offset placeholder is filled in after several chunks were appended
+        for (int j = 0; j < 50; j++)
+        {
+          auto mark = os.Mark();
+          os << j << std::string(j * 3, 'm');
+          if (j % 2)
+          {
+            os.Rollback(mark);
+          }
+          else
+          {
+            os.Commit(mark);
+          }
+        }
+        os.WriteInt(42);
+        os.Close();
+      }
+
+      RRLIB_UNIT_TESTS_EQUALITY(memory_buffer.GetSize(), chunked_buffer.GetSize());
+      RRLIB_UNIT_TESTS_ASSERT(chunked_buffer.GetChunkCount() > 20);
+      std::string chunked_contents;
+      for (size_t i = 0; i < chunked_buffer.GetChunkCount(); i++)
+      {
+        RRLIB_UNIT_TESTS_ASSERT(chunked_buffer.GetChunk(i).Size() >= 8 || i + 1 == chunked_buffer.GetChunkCount());
+        chunked_contents += chunked_buffer.GetChunk(i).ToString();
+      }
+      RRLIB_UNIT_TESTS_ASSERT(chunked_contents == std::string(memory_buffer.GetBufferPointer(), memory_buffer.GetSize()));
+    }
+
+    // read from chunked buffer
+    tInputStream is(chunked_buffer);
+    std::vector<int> read_numbers;
+    std::vector<std::string> read_strings;
+    is >> read_numbers >> read_strings;
+    RRLIB_UNIT_TESTS_ASSERT(numbers == read_numbers && strings == read_strings);
+    tIndexedContainerReader reader(is);
+    std::string element;
+    reader.Read(150, element);
+    RRLIB_UNIT_TESTS_EQUALITY(strings[150], element);
+    reader.Read(3, element);
+    RRLIB_UNIT_TESTS_EQUALITY(strings[3], element);
+    is.Seek(reader.GetEndPosition());
+    for (int j = 0; j < 50; j += 2)
+    {
+      RRLIB_UNIT_TESTS_EQUALITY(j, is.ReadInt());
+      RRLIB_UNIT_TESTS_EQUALITY(std::string(j * 3, 'm'), is.ReadString());
+    }
+    RRLIB_UNIT_TESTS_EQUALITY(42, is.ReadInt());
+    RRLIB_UNIT_TESTS_ASSERT(!is.MoreDataAvailable());
+
+    // serialize chunked buffer (same format as memory buffer)
+    tMemoryBuffer serialized;
+    tOutputStream os(serialized);
+    os << chunked_buffer << memory_buffer;
+    os.Close();
+    tInputStream is2(serialized);
+    tChunkedMemoryBuffer deserialized(100);
+    tMemoryBuffer deserialized_memory_buffer;
+    is2 >> deserialized_memory_buffer >> deserialized;
+    RRLIB_UNIT_TESTS_ASSERT(deserialized_memory_buffer == memory_buffer);
+    RRLIB_UNIT_TESTS_EQUALITY(memory_buffer.GetSize(), deserialized.GetSize());
+    tInputStream is3(deserialized);
+    is3.Seek(memory_buffer.GetSize() - 4);
+    RRLIB_UNIT_TESTS_EQUALITY(42, is3.ReadInt());
+
+    // skip offset placeholders are filled in in previous chunks
+    tChunkedMemoryBuffer indexed_buffer(256);
+    tOutputStream os2(indexed_buffer);
+    WriteIndexedContainer(os2, strings);
+    os2.WriteInt(43);
+    os2.Close();
+    RRLIB_UNIT_TESTS_ASSERT(indexed_buffer.GetChunkCount() > 20);
+    tInputStream is4(indexed_buffer);
+    tIndexedContainerReader reader2(is4);
+    reader2.Read(199, element);
+    RRLIB_UNIT_TESTS_EQUALITY(strings[199], element);
+    is4.Seek(reader2.GetEndPosition());
+    RRLIB_UNIT_TESTS_EQUALITY(43, is4.ReadInt());
+    RRLIB_UNIT_TESTS_ASSERT(!is4.MoreDataAvailable());
+
+    // rollback to mark at end of chunk (no empty chunk remains)
+    tChunkedMemoryBuffer rollback_buffer(64);
+    tOutputStream os3(rollback_buffer);
+    for (int i = 0; i < 7; i++)
+    {
+      os3.WriteLong(i);
+    }
+    auto mark = os3.Mark();
+    os3.WriteLong(7);
+    os3.WriteLong(8);
+    os3.Rollback(mark);
+    os3.Close();
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(1), rollback_buffer.GetChunkCount());
+    tInputStream is5(rollback_buffer);
+    for (int i = 0; i < 7; i++)
+    {
+      RRLIB_UNIT_TESTS_EQUALITY(static_cast<int64_t>(i), is5.ReadLong());
+    }
+    RRLIB_UNIT_TESTS_ASSERT(!is5.MoreDataAvailable());
+
+    // reading beyond the end of a short last chunk
+    tChunkedMemoryBuffer short_buffer(16);
+    tOutputStream os4(short_buffer);
+    for (int i = 0; i < 4; i++)
+    {
+      os4.WriteInt(i);
+    }
+    os4.WriteByte(1);
+    os4.WriteByte(2);
+    os4.WriteByte(3);
+    os4.Close();
+    RRLIB_UNIT_TESTS_EQUALITY(static_cast<size_t>(2), short_buffer.GetChunkCount());
+    tInputStream is6(short_buffer);
+    for (int i = 0; i < 4; i++)
+    {
+      RRLIB_UNIT_TESTS_EQUALITY(i, is6.ReadInt());
+    }
+    RRLIB_UNIT_TESTS_EXCEPTION_MESSAGE("Reading beyond last chunk must throw", is6.ReadInt(), std::out_of_range);
+  }
+
+  void TestMemoryBufferPool()
+  {
+    tMemoryBufferPool pool(4);
+    RRLIB_UNIT_TESTS_EQUALITY(-1, tMemoryBufferPool::GetCapacityClass(100));
+    RRLIB_UNIT_TESTS_EQUALITY(0, tMemoryBufferPool::GetCapacityClass(tMemoryBufferPool::cMIN_CAPACITY));
+    RRLIB_UNIT_TESTS_EQUALITY(1, tMemoryBufferPool::GetCapacityClass(tMemoryBufferPool::cMIN_CAPACITY * 3));
+
+    // returned buffers are reused (cleared)
+    tMemoryBuffer* first = nullptr;
+    {
+      tMemoryBufferPool::tPointer buffer = pool.Acquire();
+      first = buffer.get();
+      tOutputStream os(*buffer);
+      os << std::string("message");
+      os.Close();
+    }
+    tMemoryBufferPool::tPointer buffer = pool.Acquire();
+    RRLIB_UNIT_TESTS_ASSERT(buffer.get() == first && buffer->GetSize() == 0);
+
+    // buffers that grew are returned to their new capacity class
+    {
+      tOutputStream os(*buffer);
+      os << std::vector<int>(10000, 1);
+      os.Close();
+    }
+    size_t grown_capacity = buffer->GetCapacity();
+    buffer.reset();
+    tMemoryBufferPool::tPointer small_buffer = pool.Acquire(100);
+    RRLIB_UNIT_TESTS_ASSERT(small_buffer.get() != first);
+    tMemoryBufferPool::tPointer large_buffer = pool.Acquire(tMemoryBufferPool::cMIN_CAPACITY << tMemoryBufferPool::GetCapacityClass(grown_capacity));
+    RRLIB_UNIT_TESTS_ASSERT(large_buffer.get() == first);
+    large_buffer.reset();
+    small_buffer.reset();
+
+    // concurrent use
+    std::vector<std::thread> threads;
+    std::atomic<int> errors(0);
+    for (int i = 0; i < 4; i++)
+    {
+      threads.emplace_back([&pool, &errors, i]()
+      {
+        for (int j = 0; j < 2000; j++)
+        {
+          tMemoryBufferPool::tPointer buffer = pool.Acquire((j % 3) * 10000);
+          tOutputStream os(*buffer);
+          os << i << j;
+          os.Close();
+          tInputStream is(*buffer);
+          if (buffer->GetSize() != 8 || is.ReadInt() != i || is.ReadInt() != j)
+          {
+            errors++;
+          }
+        }
+      });
+    }
+    for (std::thread & thread : threads)
+    {
+      thread.join();
+    }
+    RRLIB_UNIT_TESTS_EQUALITY(0, errors.load());
+  }
+
   /*!
    * Helper method for testing binary serialization for an object of type T
    *
@@ -324,6 +1465,21 @@ private:
       string_buffer << static_cast<char>('a' + (i % 26));
     }
     TestStringSerialization<10000>({ string_buffer.str() }, 10, 1070);
+
+    // capacity of string buffer is reused
+    tMemoryBuffer mb;
+    tOutputStream os(mb);
+    os << std::string(100, 'x') << std::string("short");
+    os.Close();
+    tInputStream is(mb);
+    std::string target;
+    target.reserve(200);
+    const char* target_data = target.data();
+    is >> target;
+    RRLIB_UNIT_TESTS_EQUALITY(std::string(100, 'x'), target);
+    is >> target;
+    RRLIB_UNIT_TESTS_EQUALITY(std::string("short"), target);
+    RRLIB_UNIT_TESTS_ASSERT(target.data() == target_data);
   }
 
 };
@@ -72,6 +72,14 @@ enum class tStandardEnum : int32_t
   WORD
 };
 
+enum class tSparseEnum : int16_t
+{
+  FIRST = 1000,
+  SECOND = -5,
+  THIRD = 42,
+  FOURTH = 7
+};
+
 //----------------------------------------------------------------------
 // Function declarations
 //----------------------------------------------------------------------